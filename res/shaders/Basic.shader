@@ -6,11 +6,19 @@ layout(location = 1) in vec2 texCoord;
 
 out vec2 v_TexCoord;
 
-uniform mat4 u_MVP;
+layout(std140) uniform Frame
+{
+    mat4 u_View;
+    mat4 u_Projection;
+    mat4 u_ViewProjection;
+    vec4 u_Time;
+};
+
+uniform mat4 u_Model;
 
 void main()
 {
-    gl_Position =u_MVP * position;
+    gl_Position = u_ViewProjection * u_Model * position;
     v_TexCoord = texCoord;
 };
 
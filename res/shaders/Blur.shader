@@ -0,0 +1,36 @@
+#shader vertex
+#version 330 core
+
+// Fullscreen triangle from the vertex index, drawn without vertex buffers
+out vec2 v_TexCoord;
+
+void main()
+{
+    v_TexCoord = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(v_TexCoord * 2.0 - 1.0, 0.0, 1.0);
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+uniform vec2 u_Direction; // One texel along the blur axis
+
+// 9-tap Gaussian folded into 5 bilinear fetches
+const float c_Offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float c_Weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+void main()
+{
+    vec4 sum = texture(u_Texture, v_TexCoord) * c_Weights[0];
+    for (int i = 1; i < 3; i++)
+    {
+        sum += texture(u_Texture, v_TexCoord + u_Direction * c_Offsets[i]) * c_Weights[i];
+        sum += texture(u_Texture, v_TexCoord - u_Direction * c_Offsets[i]) * c_Weights[i];
+    }
+    color = sum;
+};
@@ -0,0 +1,29 @@
+#shader vertex
+#version 330 core
+
+// Fullscreen triangle from the vertex index, drawn without vertex buffers
+out vec2 v_TexCoord;
+
+void main()
+{
+    v_TexCoord = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(v_TexCoord * 2.0 - 1.0, 0.0, 1.0);
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Scene;
+uniform sampler2D u_Bloom;
+uniform float u_BloomStrength;
+
+void main()
+{
+    vec3 scene = texture(u_Scene, v_TexCoord).rgb;
+    vec3 bloom = texture(u_Bloom, v_TexCoord).rgb;
+    color = vec4(scene + bloom * u_BloomStrength, 1.0);
+};
@@ -0,0 +1,63 @@
+#shader compute
+#version 430 core
+
+// One invocation per submitted draw. Visible draws are appended to their
+// material bucket in the indirect buffer, with the model matrix written at
+// the slot their baseInstance points to.
+layout(local_size_x = 64) in;
+
+struct DrawInput
+{
+    mat4 Model;
+    vec4 BoundsMin;
+    vec4 BoundsMax;
+    uvec4 Mesh;   // index count, first index, base vertex, bucket
+    uvec4 Bucket; // first slot of the bucket
+};
+
+struct DrawCommand
+{
+    uint Count;
+    uint InstanceCount;
+    uint FirstIndex;
+    int BaseVertex;
+    uint BaseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer Inputs { DrawInput u_Inputs[]; };
+layout(std430, binding = 1) writeonly buffer Commands { DrawCommand u_Commands[]; };
+layout(std430, binding = 2) writeonly buffer Models { mat4 u_Models[]; };
+layout(std430, binding = 3) buffer Counts { uint u_Counts[]; };
+
+uniform vec4 u_Planes[6];
+uniform int u_DrawCount;
+
+bool IsVisible(mat4 model, vec3 boundsMin, vec3 boundsMax)
+{
+    vec3 center = (model * vec4((boundsMin + boundsMax) * 0.5, 1.0)).xyz;
+    vec3 extent = (boundsMax - boundsMin) * 0.5;
+    vec3 worldExtent = abs(model[0].xyz) * extent.x + abs(model[1].xyz) * extent.y + abs(model[2].xyz) * extent.z;
+    for (int i = 0; i < 6; i++)
+    {
+        float distance = dot(u_Planes[i].xyz, center) + u_Planes[i].w;
+        float radius = dot(abs(u_Planes[i].xyz), worldExtent);
+        if (distance + radius < 0.0)
+            return false;
+    }
+    return true;
+}
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= uint(u_DrawCount))
+        return;
+
+    DrawInput draw = u_Inputs[index];
+    if (!IsVisible(draw.Model, draw.BoundsMin.xyz, draw.BoundsMax.xyz))
+        return;
+
+    uint slot = draw.Bucket.x + atomicAdd(u_Counts[draw.Mesh.w], 1u);
+    u_Commands[slot] = DrawCommand(draw.Mesh.x, 1u, draw.Mesh.y, int(draw.Mesh.z), slot);
+    u_Models[slot] = draw.Model;
+};
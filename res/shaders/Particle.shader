@@ -0,0 +1,44 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec3 a_Position; // per instance from here on
+layout(location = 2) in float a_Size;
+layout(location = 3) in vec4 a_Color;
+
+out vec4 v_Color;
+out vec2 v_Corner;
+
+layout(std140) uniform Frame
+{
+    mat4 u_View;
+    mat4 u_Projection;
+    mat4 u_ViewProjection;
+    vec4 u_Time;
+};
+
+void main()
+{
+    // Camera right and up are the first two rows of the view rotation
+    vec3 right = vec3(u_View[0][0], u_View[1][0], u_View[2][0]);
+    vec3 up = vec3(u_View[0][1], u_View[1][1], u_View[2][1]);
+    vec3 position = a_Position + (right * a_Corner.x + up * a_Corner.y) * a_Size;
+    gl_Position = u_ViewProjection * vec4(position, 1.0);
+    v_Color = a_Color;
+    v_Corner = a_Corner * 2.0;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_Corner;
+
+void main()
+{
+    // Round particles with a soft edge
+    float falloff = 1.0 - smoothstep(0.6, 1.0, length(v_Corner));
+    color = vec4(v_Color.rgb, v_Color.a * falloff);
+};
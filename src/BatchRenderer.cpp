@@ -0,0 +1,230 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "VertexBufferLayout.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "Profiler.h"
+#include "Font.h"
+#include "TextObject.h"
+
+static constexpr glm::vec2 s_QuadTexCoords[4] = {
+    { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }
+};
+
+static constexpr glm::vec4 s_QuadPositions[4] = {
+    { -0.5f, -0.5f, 0.0f, 1.0f },
+    {  0.5f, -0.5f, 0.0f, 1.0f },
+    {  0.5f,  0.5f, 0.0f, 1.0f },
+    { -0.5f,  0.5f, 0.0f, 1.0f }
+};
+
+static std::vector<unsigned int> GenerateQuadIndices(unsigned int quadCount) {
+    std::vector<unsigned int> indices(quadCount * 6);
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < indices.size(); i += 6) {
+        indices[i + 0] = offset + 0;
+        indices[i + 1] = offset + 1;
+        indices[i + 2] = offset + 2;
+
+        indices[i + 3] = offset + 2;
+        indices[i + 4] = offset + 3;
+        indices[i + 5] = offset + 0;
+
+        offset += 4;
+    }
+    return indices;
+}
+
+static constexpr unsigned char s_WhitePixel[4] = { 0xff, 0xff, 0xff, 0xff };
+
+BatchRenderer::BatchRenderer(const std::string &shaderPath)
+    : m_Vertices(MaxVertices),
+      m_VertexBuffer(2 * MaxVertices * sizeof(QuadVertex)),
+      m_IndexBuffer(GenerateQuadIndices(MaxQuads).data(), MaxIndices),
+      m_Shader(shaderPath),
+      m_WhiteTexture(1, 1, s_WhitePixel) {
+
+    VertexBufferLayout layout;
+    layout.Push<float>(3); // position
+    layout.Push<float>(4); // color
+    layout.Push<float>(2); // texture coordinates
+    layout.Push<float>(1); // texture slot
+    m_VertexArray.AddBuffer(m_VertexBuffer, layout);
+
+    int samplers[MaxTextureSlots];
+    for (int i = 0; i < static_cast<int>(MaxTextureSlots); i++)
+        samplers[i] = i;
+
+    m_Shader.Bind();
+    m_Shader.SetUniform1iv("u_Textures", MaxTextureSlots, samplers);
+    m_Shader.Unbind();
+
+    m_TextureSlots[0] = m_WhiteTexture.GetRendererID();
+    m_TextureSlotCount = 1;
+}
+
+void BatchRenderer::BeginScene() {
+    StartBatch();
+}
+
+void BatchRenderer::EndScene() {
+    Flush();
+    m_VertexBuffer.EndFrame();
+}
+
+void BatchRenderer::StartBatch() {
+    m_QuadCount = 0;
+    m_TextureSlotCount = 1;
+}
+
+void BatchRenderer::Flush() {
+    if (m_QuadCount == 0) {
+        StartBatch();
+        return;
+    }
+
+    PROFILE_GPU_SCOPE("BatchRenderer::Flush");
+
+    const unsigned int size = m_QuadCount * 4 * sizeof(QuadVertex);
+    unsigned int offset;
+    void* data = m_VertexBuffer.Allocate(size, sizeof(QuadVertex), offset);
+    std::memcpy(data, m_Vertices.data(), size);
+    m_VertexBuffer.Commit();
+
+    for (unsigned int i = 0; i < m_TextureSlotCount; i++)
+        GLStateCache::BindTexture(i, GL_TEXTURE_2D, m_TextureSlots[i]);
+
+    m_Shader.Bind();
+    m_VertexArray.Bind();
+    m_IndexBuffer.Bind();
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, m_QuadCount * 6, GL_UNSIGNED_INT, nullptr,
+        static_cast<GLint>(offset / sizeof(QuadVertex))));
+
+    m_Stats.FlushCount++;
+    m_Stats.DrawCalls++;
+    StartBatch();
+}
+
+float BatchRenderer::GetTextureSlot(const Texture &texture) {
+    // A full batch would be flushed by the next PushQuad, dropping the slot taken here
+    if (m_QuadCount >= MaxQuads)
+        Flush();
+
+    const unsigned int id = texture.GetRendererID();
+    for (unsigned int i = 1; i < m_TextureSlotCount; i++) {
+        if (m_TextureSlots[i] == id)
+            return static_cast<float>(i);
+    }
+
+    if (m_TextureSlotCount >= MaxTextureSlots)
+        Flush();
+
+    m_TextureSlots[m_TextureSlotCount] = id;
+    return static_cast<float>(m_TextureSlotCount++);
+}
+
+void BatchRenderer::PushQuad(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, const float texIndex,
+                             const glm::vec2 &uvMin, const glm::vec2 &uvMax) {
+    if (m_QuadCount >= MaxQuads)
+        Flush();
+
+    // Axis-aligned quads skip the matrix multiply entirely
+    QuadVertex* vertex = &m_Vertices[m_QuadCount * 4];
+    for (unsigned int i = 0; i < 4; i++, vertex++) {
+        vertex->Position = { position.x + s_QuadPositions[i].x * size.x,
+                             position.y + s_QuadPositions[i].y * size.y,
+                             position.z };
+        vertex->Color = color;
+        vertex->TexCoord = uvMin + s_QuadTexCoords[i] * (uvMax - uvMin);
+        vertex->TexIndex = texIndex;
+    }
+
+    m_QuadCount++;
+    m_Stats.QuadCount++;
+}
+
+void BatchRenderer::PushQuad(const glm::mat4 &transform, const glm::vec4 &color, const float texIndex) {
+    if (m_QuadCount >= MaxQuads)
+        Flush();
+
+    QuadVertex* vertex = &m_Vertices[m_QuadCount * 4];
+    for (unsigned int i = 0; i < 4; i++, vertex++) {
+        vertex->Position = glm::vec3(transform * s_QuadPositions[i]);
+        vertex->Color = color;
+        vertex->TexCoord = s_QuadTexCoords[i];
+        vertex->TexIndex = texIndex;
+    }
+
+    m_QuadCount++;
+    m_Stats.QuadCount++;
+}
+
+void BatchRenderer::DrawQuad(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color) {
+    PushQuad({ position.x, position.y, 0.0f }, size, color, 0.0f);
+}
+
+void BatchRenderer::DrawQuad(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color) {
+    PushQuad(position, size, color, 0.0f);
+}
+
+void BatchRenderer::DrawQuad(const glm::vec2 &position, const glm::vec2 &size, const Texture &texture, const glm::vec4 &tint) {
+    DrawQuad({ position.x, position.y, 0.0f }, size, texture, tint);
+}
+
+void BatchRenderer::DrawQuad(const glm::vec3 &position, const glm::vec2 &size, const Texture &texture, const glm::vec4 &tint) {
+    const float texIndex = GetTextureSlot(texture);
+    PushQuad(position, size, tint, texIndex);
+}
+
+void BatchRenderer::DrawQuad(const glm::vec3 &position, const glm::vec2 &size, const Texture &texture,
+                             const glm::vec2 &uvMin, const glm::vec2 &uvMax, const glm::vec4 &tint) {
+    const float texIndex = GetTextureSlot(texture);
+    PushQuad(position, size, tint, texIndex, uvMin, uvMax);
+}
+
+void BatchRenderer::DrawQuad(const glm::mat4 &transform, const glm::vec4 &color) {
+    PushQuad(transform, color, 0.0f);
+}
+
+void BatchRenderer::DrawQuad(const glm::mat4 &transform, const Texture &texture, const glm::vec4 &tint) {
+    const float texIndex = GetTextureSlot(texture);
+    PushQuad(transform, tint, texIndex);
+}
+
+void BatchRenderer::DrawQuads(const QuadVertex *vertices, unsigned int quadCount, const Texture &texture, bool distanceField) {
+    while (quadCount > 0) {
+        const float texIndex = GetTextureSlot(texture) + (distanceField ? static_cast<float>(MaxTextureSlots) : 0.0f);
+        const unsigned int count = std::min(quadCount, MaxQuads - m_QuadCount);
+
+        QuadVertex* destination = &m_Vertices[m_QuadCount * 4];
+        std::memcpy(destination, vertices, count * 4 * sizeof(QuadVertex));
+        for (unsigned int i = 0; i < count * 4; i++)
+            destination[i].TexIndex = texIndex;
+
+        vertices += count * 4;
+        quadCount -= count;
+        m_QuadCount += count;
+        m_Stats.QuadCount += count;
+    }
+}
+
+void BatchRenderer::DrawText(TextObject &text) {
+    // A font that failed to load has no atlas to sample
+    if (!text.GetFont().IsValid())
+        return;
+    const std::vector<QuadVertex>& vertices = text.GetVertices();
+    if (vertices.empty())
+        return;
+    DrawQuads(vertices.data(), static_cast<unsigned int>(vertices.size() / 4), text.GetFont().GetTexture(), true);
+}
+
+void BatchRenderer::ResetStats() {
+    m_Stats = Stats();
+}
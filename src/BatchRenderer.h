@@ -0,0 +1,92 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "VertexArray.h"
+#include "DynamicVertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Texture.h"
+
+class TextObject;
+
+struct QuadVertex {
+    glm::vec3 Position;
+    glm::vec4 Color;
+    glm::vec2 TexCoord;
+    // Texture slot; slots offset by MaxTextureSlots sample a distance field
+    float TexIndex;
+};
+
+// Collects quads into a persistent CPU-side vertex array and draws them from
+// one streaming vertex buffer, flushing only when the batch or the texture
+// slots are full.
+class BatchRenderer {
+public:
+    static constexpr unsigned int MaxQuads = 10000;
+    static constexpr unsigned int MaxVertices = MaxQuads * 4;
+    static constexpr unsigned int MaxIndices = MaxQuads * 6;
+    static constexpr unsigned int MaxTextureSlots = 16;
+
+    struct Stats {
+        unsigned int QuadCount = 0;
+        unsigned int FlushCount = 0;
+        unsigned int DrawCalls = 0;
+    };
+
+private:
+    std::vector<QuadVertex> m_Vertices;
+    unsigned int m_QuadCount{};
+
+    VertexArray m_VertexArray;
+    DynamicVertexBuffer m_VertexBuffer;
+    IndexBuffer m_IndexBuffer;
+    Shader m_Shader;
+    Texture m_WhiteTexture;
+
+    std::array<unsigned int, MaxTextureSlots> m_TextureSlots{};
+    unsigned int m_TextureSlotCount{};
+
+    Stats m_Stats;
+
+public:
+    explicit BatchRenderer(const std::string& shaderPath = "res/shaders/Batch.shader");
+
+    // The camera comes from the "Frame" uniform block set by Renderer::BeginFrame
+    void BeginScene();
+    void EndScene();
+    // Draws the quads queued so far and starts a new batch, e.g. before
+    // drawing something else that has to land on top of them
+    void Flush();
+
+    // position is the center of the quad
+    void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+    void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+    void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint = glm::vec4(1.0f));
+    void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint = glm::vec4(1.0f));
+    // Draws the [uvMin, uvMax] sub-rectangle of texture, e.g. an AtlasRegion
+    void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Texture& texture,
+                  const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& tint = glm::vec4(1.0f));
+    void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
+    void DrawQuad(const glm::mat4& transform, const Texture& texture, const glm::vec4& tint = glm::vec4(1.0f));
+    // Copies quads built ahead of time, four vertices each, pointing them at
+    // texture's slot. distanceField treats the texture's alpha as an SDF.
+    void DrawQuads(const QuadVertex* vertices, unsigned int quadCount, const Texture& texture, bool distanceField = false);
+    void DrawText(TextObject& text);
+
+    inline const Stats& GetStats() const { return m_Stats; }
+    void ResetStats();
+
+private:
+    void StartBatch();
+    float GetTextureSlot(const Texture& texture);
+    void PushQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, float texIndex,
+                  const glm::vec2& uvMin = glm::vec2(0.0f), const glm::vec2& uvMax = glm::vec2(1.0f));
+    void PushQuad(const glm::mat4& transform, const glm::vec4& color, float texIndex);
+};
@@ -0,0 +1,1450 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+// Renders scripted scenes for a fixed number of frames and prints frame time
+// percentiles and draw/bind counts as JSON, so regressions in the renderer
+// show up as numbers. Runs headless by default.
+//
+//   ModernOpenGLBenchmark [--scene quads|textures|shaders|transforms|unsorted|queue|
+//                         jobs|world|culling|text|postprocess|meshes|meshpool|
+//                         meshstream|indirect|indirect_cpu|particles|all] [--count N] [--frames N]
+//                         [--warmup N] [--width W] [--height H] [--window] [--font file.ttf]
+//                         [--output file.json] [--trace trace.json]
+//
+// --trace writes the profiler's last frames as a chrome://tracing file; it
+// needs a build with MODERNOPENGL_PROFILING, which also adds the markers'
+// cost to the timings.
+//
+// --cpu times the CPU kernels alone, with no window or GL context, so it also
+// runs on machines without a GPU:
+//
+//   ModernOpenGLBenchmark --cpu [--scene particles_update|particles_jobs|packing|all] ...
+
+#include <GL/glew.h> // Must be included before GLFW
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Renderer.h"
+#include "BatchRenderer.h"
+#include "Culling.h"
+#include "Font.h"
+#include "Framebuffer.h"
+#include "GLStateCache.h"
+#include "IndirectRenderer.h"
+#include "JobSystem.h"
+#include "MeshLoader.h"
+#include "MeshPool.h"
+#include "ParticleRenderer.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
+#include "RenderGraph.h"
+#include "RenderQueue.h"
+#include "TextObject.h"
+#include "TransformSystem.h"
+#include "Texture.h"
+#include "VertexBufferLayout.h"
+#include "VertexPacking.h"
+#include "Window.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+struct BenchmarkOptions {
+    std::string Scene = "all";
+    int Count = 0;  // 0 picks the scene default
+    int Frames = 300;
+    int Warmup = 30;
+    int Width = 960;
+    int Height = 540;
+    bool Headless = true;
+    bool CpuOnly = false;
+    std::string Font = "res/fonts/SourceCodePro-Regular.ttf";
+    std::string Output;
+    std::string Trace;
+};
+
+// Scenes are created from their count and size alone; the font and the
+// framebuffer every scene renders into are shared
+static std::string s_FontPath;
+static Framebuffer* s_Framebuffer = nullptr;
+// Any scene reported an error; the exit code says so
+static bool s_Failed = false;
+
+struct FrameCounters {
+    unsigned int DrawCalls = 0;
+    unsigned int BindsIssued = 0;
+    unsigned int BindsSkipped = 0;
+};
+
+class BenchmarkScene {
+public:
+    virtual ~BenchmarkScene() = default;
+    virtual const char* GetName() const = 0;
+    virtual void Render(Renderer& renderer, BatchRenderer& batch) = 0;
+    // Draws issued outside Renderer and BatchRenderer during the last Render
+    virtual unsigned int GetDrawCalls() const { return 0; }
+    // For scenes that pick a code path from the context, the one they ran
+    virtual const char* GetPath() const { return nullptr; }
+    // Set when the scene cannot run as intended; its row then reports the
+    // error instead of timings
+    virtual std::string GetError() const { return {}; }
+};
+
+// N colored quads through the BatchRenderer
+class QuadScene : public BenchmarkScene {
+private:
+    std::vector<glm::vec3> m_Positions;
+    std::vector<glm::vec4> m_Colors;
+public:
+    QuadScene(int count, int width, int height) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width));
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height));
+        std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+        for (int i = 0; i < count; i++) {
+            m_Positions.emplace_back(x(random), y(random), 0.0f);
+            m_Colors.emplace_back(channel(random), channel(random), channel(random), 1.0f);
+        }
+    }
+
+    const char* GetName() const override { return "quads"; }
+
+    void Render(Renderer&, BatchRenderer& batch) override {
+        batch.BeginScene();
+        for (size_t i = 0; i < m_Positions.size(); i++)
+            batch.DrawQuad(m_Positions[i], glm::vec2(8.0f), m_Colors[i]);
+        batch.EndScene();
+    }
+};
+
+// One quad per texture, so the batch runs out of texture slots every 15 quads
+class TextureScene : public BenchmarkScene {
+private:
+    std::vector<std::unique_ptr<Texture>> m_Textures;
+    int m_Width;
+    int m_Height;
+public:
+    TextureScene(int count, int width, int height) : m_Width(width), m_Height(height) {
+        std::vector<unsigned char> pixels(16 * 16 * 4);
+        for (int i = 0; i < count; i++) {
+            for (size_t p = 0; p < pixels.size(); p += 4) {
+                pixels[p + 0] = static_cast<unsigned char>(i * 37);
+                pixels[p + 1] = static_cast<unsigned char>(i * 91);
+                pixels[p + 2] = static_cast<unsigned char>(p);
+                pixels[p + 3] = 255;
+            }
+            m_Textures.push_back(std::make_unique<Texture>(16, 16, pixels.data()));
+        }
+    }
+
+    const char* GetName() const override { return "textures"; }
+
+    void Render(Renderer&, BatchRenderer& batch) override {
+        const int columns = std::max(1, m_Width / 16);
+        batch.BeginScene();
+        for (size_t i = 0; i < m_Textures.size(); i++) {
+            const glm::vec2 position(8.0f + (i % columns) * 16.0f, 8.0f + (i / columns % (m_Height / 16)) * 16.0f);
+            batch.DrawQuad(position, glm::vec2(16.0f), *m_Textures[i]);
+        }
+        batch.EndScene();
+    }
+};
+
+// One draw per program, each with its own uniform upload
+class ShaderScene : public BenchmarkScene {
+private:
+    std::vector<std::unique_ptr<Shader>> m_Shaders;
+    std::vector<UniformHandle<glm::mat4>> m_ModelHandles;
+    VertexArray m_VertexArray;
+    std::unique_ptr<VertexBuffer> m_VertexBuffer;
+    std::unique_ptr<IndexBuffer> m_IndexBuffer;
+    Texture m_Texture;
+    int m_Width;
+public:
+    ShaderScene(int count, int width, int)
+        : m_Texture(1, 1, std::vector<unsigned char>{ 255, 255, 255, 255 }.data()), m_Width(width) {
+        float positions[] = {
+            -8.0f, -8.0f, 0.0f, 0.0f,
+             8.0f, -8.0f, 1.0f, 0.0f,
+             8.0f,  8.0f, 1.0f, 1.0f,
+            -8.0f,  8.0f, 0.0f, 1.0f
+        };
+        unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+
+        m_VertexBuffer = std::make_unique<VertexBuffer>(positions, sizeof(positions));
+        VertexBufferLayout layout;
+        layout.Push<float>(2);
+        layout.Push<float>(2);
+        m_VertexArray.AddBuffer(*m_VertexBuffer, layout);
+        m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+        // Separate program objects built from the same source
+        for (int i = 0; i < count; i++) {
+            m_Shaders.push_back(std::make_unique<Shader>("res/shaders/Basic.shader"));
+            m_Shaders.back()->Bind();
+            m_Shaders.back()->SetUniform1i("u_Texture", 0);
+            m_ModelHandles.push_back(m_Shaders.back()->GetUniformHandle<glm::mat4>("u_Model"));
+        }
+    }
+
+    const char* GetName() const override { return "shaders"; }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        const int columns = std::max(1, m_Width / 16);
+        m_Texture.Bind();
+        for (size_t i = 0; i < m_Shaders.size(); i++) {
+            const glm::vec3 position(8.0f + (i % columns) * 16.0f, 8.0f + (i / columns) * 16.0f, 0.0f);
+            m_Shaders[i]->Bind();
+            m_Shaders[i]->SetUniform(m_ModelHandles[i], glm::translate(glm::mat4(1.0f), position));
+            renderer.Draw(m_VertexArray, *m_IndexBuffer, *m_Shaders[i]);
+        }
+    }
+};
+
+// Many draws over a few shaders and textures, submitted in random order.
+// "unsorted" draws them as submitted, "queue" lets the RenderQueue sort them,
+// and "jobs" records into the queue from every JobSystem thread at once.
+class MixedScene : public BenchmarkScene {
+public:
+    enum class Mode { Unsorted, Queue, Jobs };
+private:
+    static constexpr size_t RecordBatchSize = 512;
+    static constexpr int ShaderCount = 8;
+    static constexpr int TextureCount = 8;
+
+    struct Item {
+        int Shader;
+        int Texture;
+        glm::mat4 Model;
+    };
+
+    std::vector<std::unique_ptr<Shader>> m_Shaders;
+    std::vector<UniformHandle<glm::mat4>> m_ModelHandles;
+    std::vector<std::unique_ptr<Texture>> m_Textures;
+    std::vector<Item> m_Items;
+    VertexArray m_VertexArray;
+    std::unique_ptr<VertexBuffer> m_VertexBuffer;
+    std::unique_ptr<IndexBuffer> m_IndexBuffer;
+    RenderQueue m_Queue;
+    std::unique_ptr<JobSystem> m_Jobs;
+    Mode m_Mode;
+public:
+    MixedScene(int count, int width, int height, Mode mode) : m_Mode(mode) {
+        float positions[] = {
+            -4.0f, -4.0f, 0.0f, 0.0f,
+             4.0f, -4.0f, 1.0f, 0.0f,
+             4.0f,  4.0f, 1.0f, 1.0f,
+            -4.0f,  4.0f, 0.0f, 1.0f
+        };
+        unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+
+        m_VertexBuffer = std::make_unique<VertexBuffer>(positions, sizeof(positions));
+        VertexBufferLayout layout;
+        layout.Push<float>(2);
+        layout.Push<float>(2);
+        m_VertexArray.AddBuffer(*m_VertexBuffer, layout);
+        m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+        for (int i = 0; i < ShaderCount; i++) {
+            m_Shaders.push_back(std::make_unique<Shader>("res/shaders/Basic.shader"));
+            m_Shaders.back()->Bind();
+            m_Shaders.back()->SetUniform1i("u_Texture", 0);
+            m_ModelHandles.push_back(m_Shaders.back()->GetUniformHandle<glm::mat4>("u_Model"));
+        }
+        for (int i = 0; i < TextureCount; i++) {
+            const unsigned char pixel[4] = { static_cast<unsigned char>(i * 32), 128, 255, 255 };
+            m_Textures.push_back(std::make_unique<Texture>(1, 1, pixel));
+        }
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width));
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height));
+        for (int i = 0; i < count; i++) {
+            m_Items.push_back({ static_cast<int>(random() % ShaderCount), static_cast<int>(random() % TextureCount),
+                                glm::translate(glm::mat4(1.0f), glm::vec3(x(random), y(random), 0.0f)) });
+        }
+        if (m_Mode == Mode::Jobs)
+            m_Jobs = std::make_unique<JobSystem>();
+    }
+
+    const char* GetName() const override {
+        switch (m_Mode) {
+            case Mode::Unsorted: return "unsorted";
+            case Mode::Queue: return "queue";
+            case Mode::Jobs: return "jobs";
+        }
+        return "";
+    }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        switch (m_Mode) {
+            case Mode::Unsorted:
+                for (const Item& item : m_Items) {
+                    Shader& shader = *m_Shaders[item.Shader];
+                    m_Textures[item.Texture]->Bind();
+                    shader.Bind();
+                    shader.SetUniform(m_ModelHandles[item.Shader], item.Model);
+                    renderer.Draw(m_VertexArray, *m_IndexBuffer, shader);
+                }
+                return;
+            case Mode::Queue:
+                Record(m_Queue.GetCommandBuffer(), 0, m_Items.size());
+                break;
+            case Mode::Jobs:
+                // Each thread records into its own command buffer; only Execute touches GL
+                m_Jobs->ParallelFor(m_Items.size(), RecordBatchSize, [this](size_t begin, size_t end) {
+                    Record(m_Queue.GetCommandBuffer(), begin, end);
+                });
+                break;
+        }
+        m_Queue.Execute();
+    }
+
+    unsigned int GetDrawCalls() const override { return m_Mode != Mode::Unsorted ? m_Queue.GetStats().Commands : 0; }
+
+private:
+    void Record(RenderQueue::CommandBuffer& commands, size_t begin, size_t end) const {
+        for (size_t i = begin; i < end; i++) {
+            const Item& item = m_Items[i];
+            commands.Submit(m_VertexArray, *m_IndexBuffer, *m_Shaders[item.Shader], m_Textures[item.Texture].get(),
+                            m_ModelHandles[item.Shader], item.Model);
+        }
+    }
+};
+
+// Hierarchies of 64 transforms whose roots spin every frame, so every world
+// matrix is recomputed and re-uploaded for one instanced draw
+class TransformScene : public BenchmarkScene {
+private:
+    static constexpr int GroupSize = 64;
+
+    TransformSystem m_Transforms;
+    std::vector<TransformID> m_Roots;
+    VertexArray m_VertexArray;
+    std::unique_ptr<VertexBuffer> m_VertexBuffer;
+    std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+    std::unique_ptr<IndexBuffer> m_IndexBuffer;
+    Shader m_Shader;
+    float m_Angle = 0.0f;
+public:
+    TransformScene(int count, int width, int height) : m_Shader("res/shaders/Instanced.shader") {
+        float positions[] = {
+            -2.0f, -2.0f, 0.0f, 0.0f,
+             2.0f, -2.0f, 1.0f, 0.0f,
+             2.0f,  2.0f, 1.0f, 1.0f,
+            -2.0f,  2.0f, 0.0f, 1.0f
+        };
+        unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+
+        m_VertexBuffer = std::make_unique<VertexBuffer>(positions, sizeof(positions));
+        VertexBufferLayout layout;
+        layout.Push<float>(2);
+        layout.Push<float>(2);
+        m_VertexArray.AddBuffer(*m_VertexBuffer, layout);
+        m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width));
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height));
+        std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+        m_Transforms.Reserve(count);
+        for (int i = 0; i < count; i++) {
+            if (i % GroupSize == 0)
+                m_Roots.push_back(m_Transforms.Create(glm::vec3(x(random), y(random), 0.0f)));
+            else
+                m_Transforms.Create(glm::vec3(offset(random), offset(random), 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f), m_Roots.back());
+        }
+
+        m_InstanceBuffer = std::make_unique<VertexBuffer>(count * sizeof(glm::mat4));
+        VertexBufferLayout instanceLayout;
+        instanceLayout.Push<glm::mat4>(1, 1);
+        m_VertexArray.AddBuffer(*m_InstanceBuffer, instanceLayout);
+    }
+
+    const char* GetName() const override { return "transforms"; }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        m_Angle += 0.01f;
+        const glm::quat rotation = glm::angleAxis(m_Angle, glm::vec3(0.0f, 0.0f, 1.0f));
+        for (const TransformID root : m_Roots)
+            m_Transforms.SetRotation(root, rotation);
+        m_Transforms.Update();
+
+        const TransformID begin = m_Transforms.GetChangedBegin();
+        const TransformID end = m_Transforms.GetChangedEnd();
+        m_InstanceBuffer->SetData(m_Transforms.GetWorldMatrices() + begin, (end - begin) * sizeof(glm::mat4), begin * sizeof(glm::mat4));
+        renderer.DrawInstanced(m_VertexArray, *m_IndexBuffer, m_Shader, static_cast<unsigned int>(m_Transforms.GetCount()));
+    }
+};
+
+// A world four screens wide and tall under a panning camera, with a slice of
+// the quads moving every frame. With culling on, only what the spatial grid
+// finds inside the frustum reaches the batch.
+class WorldScene : public BenchmarkScene {
+private:
+    static constexpr float QuadSize = 8.0f;
+    static constexpr int MovingStride = 16;
+
+    SpatialGrid m_Grid;
+    std::vector<glm::vec3> m_Positions;
+    std::vector<glm::vec4> m_Colors;
+    std::vector<SpatialGrid::ObjectID> m_Visible;
+    glm::mat4 m_Projection;
+    float m_WorldWidth;
+    float m_WorldHeight;
+    int m_Frame = 0;
+    bool m_Culling;
+public:
+    WorldScene(int count, int width, int height, bool culling)
+        : m_Grid(64.0f), m_Projection(glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height), -1.0f, 1.0f)),
+          m_WorldWidth(width * 4.0f), m_WorldHeight(height * 4.0f), m_Culling(culling) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, m_WorldWidth);
+        std::uniform_real_distribution<float> y(0.0f, m_WorldHeight);
+        std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+        for (int i = 0; i < count; i++) {
+            m_Positions.emplace_back(x(random), y(random), 0.0f);
+            m_Colors.emplace_back(channel(random), channel(random), channel(random), 1.0f);
+            m_Grid.Insert(GetBounds(m_Positions.back()));
+        }
+    }
+
+    const char* GetName() const override { return m_Culling ? "culling" : "world"; }
+
+    void Render(Renderer& renderer, BatchRenderer& batch) override {
+        m_Frame++;
+        for (size_t i = m_Frame % MovingStride; i < m_Positions.size(); i += MovingStride) {
+            glm::vec3& position = m_Positions[i];
+            position.x = std::fmod(position.x + 3.0f, m_WorldWidth);
+            if (m_Culling)
+                m_Grid.Update(static_cast<SpatialGrid::ObjectID>(i), GetBounds(position));
+        }
+
+        // The camera sweeps the world diagonally and wraps around
+        const glm::vec3 camera(std::fmod(m_Frame * 4.0f, m_WorldWidth * 0.75f), std::fmod(m_Frame * 2.0f, m_WorldHeight * 0.75f), 0.0f);
+        const glm::mat4 view = glm::translate(glm::mat4(1.0f), -camera);
+        renderer.BeginFrame(view, m_Projection, m_Frame / 60.0f, 1.0f / 60.0f);
+
+        batch.BeginScene();
+        if (m_Culling) {
+            m_Visible.clear();
+            m_Grid.Query(Frustum(m_Projection * view), m_Visible);
+            for (const SpatialGrid::ObjectID id : m_Visible)
+                batch.DrawQuad(m_Positions[id], glm::vec2(QuadSize), m_Colors[id]);
+        } else {
+            for (size_t i = 0; i < m_Positions.size(); i++)
+                batch.DrawQuad(m_Positions[i], glm::vec2(QuadSize), m_Colors[i]);
+        }
+        batch.EndScene();
+    }
+
+private:
+    static AABB GetBounds(const glm::vec3& position) {
+        const glm::vec3 half(QuadSize * 0.5f, QuadSize * 0.5f, 0.0f);
+        return { position - half, position + half };
+    }
+};
+
+// N retained labels, a sixteenth of which change their text every frame, as
+// a HUD full of counters would. Unchanged labels only copy their quads.
+class TextScene : public BenchmarkScene {
+private:
+    static constexpr int ChangedStride = 16;
+
+    Font m_Font;
+    std::vector<TextObject> m_Labels;
+    int m_Frame = 0;
+public:
+    TextScene(int count, int width, int height) : m_Font(s_FontPath) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width) - 120.0f);
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height) - 16.0f);
+        m_Labels.reserve(count);
+        for (int i = 0; i < count; i++)
+            m_Labels.emplace_back(m_Font, "Label " + std::to_string(i), glm::vec3(x(random), y(random), 0.0f), 14.0f);
+    }
+
+    const char* GetName() const override { return "text"; }
+    std::string GetError() const override { return m_Font.IsValid() ? std::string() : "failed to load font '" + s_FontPath + "'"; }
+
+    void Render(Renderer&, BatchRenderer& batch) override {
+        m_Frame++;
+        for (size_t i = m_Frame % ChangedStride; i < m_Labels.size(); i += ChangedStride)
+            m_Labels[i].SetText("Value " + std::to_string(m_Frame * 7 + static_cast<int>(i)));
+
+        batch.BeginScene();
+        for (TextObject& label : m_Labels)
+            batch.DrawText(label);
+        batch.EndScene();
+    }
+};
+
+// The quads scene rendered offscreen, blurred at half size in two rounds and
+// added back on top, all through a RenderGraph. The four blur targets share
+// two textures, and a debug view nothing reads is culled. The first frame's
+// output is read back and checked against the scene underneath it.
+class PostProcessScene : public BenchmarkScene {
+private:
+    std::vector<glm::vec3> m_Positions;
+    std::vector<glm::vec4> m_Colors;
+    RenderGraph m_Graph;
+    Shader m_Blur;
+    UniformHandle<glm::vec2> m_BlurDirection;
+    Shader m_Composite;
+    int m_Width;
+    int m_Height;
+    bool m_Checked = false;
+    std::string m_Error;
+public:
+    PostProcessScene(int count, int width, int height)
+        : m_Blur("res/shaders/Blur.shader"), m_Composite("res/shaders/Composite.shader"), m_Width(width), m_Height(height) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width));
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height));
+        std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+        for (int i = 0; i < count; i++) {
+            m_Positions.emplace_back(x(random), y(random), 0.0f);
+            m_Colors.emplace_back(channel(random), channel(random), channel(random), 1.0f);
+        }
+
+        m_Blur.Bind();
+        m_Blur.SetUniform1i("u_Texture", 0);
+        m_BlurDirection = m_Blur.GetUniformHandle<glm::vec2>("u_Direction");
+        m_Composite.Bind();
+        m_Composite.SetUniform1i("u_Scene", 0);
+        m_Composite.SetUniform1i("u_Bloom", 1);
+        m_Composite.SetUniform1f("u_BloomStrength", 1.5f);
+    }
+
+    const char* GetName() const override { return "postprocess"; }
+
+    void Render(Renderer& renderer, BatchRenderer& batch) override {
+        using ResourceID = RenderGraph::ResourceID;
+        const RenderTargetDescription full{ m_Width, m_Height, RenderTargetFormat::RGBA16F };
+        const RenderTargetDescription half{ m_Width / 2, m_Height / 2, RenderTargetFormat::RGBA8 };
+
+        m_Graph.Reset();
+        const ResourceID output = m_Graph.Import("output", s_Framebuffer, m_Width, m_Height);
+        const ResourceID scene = m_Graph.Create("scene", full);
+        m_Graph.AddPass("scene", [&](RenderGraph::Builder& builder) { builder.Write(scene); },
+            [&](const RenderGraph::Context&) {
+                renderer.Clear();
+                batch.BeginScene();
+                for (size_t i = 0; i < m_Positions.size(); i++)
+                    batch.DrawQuad(m_Positions[i], glm::vec2(8.0f), m_Colors[i]);
+                batch.EndScene();
+            });
+
+        ResourceID bloom = scene;
+        for (int round = 0; round < 2; round++) {
+            for (const glm::vec2 axis : { glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f) }) {
+                const ResourceID source = bloom;
+                const ResourceID blurred = m_Graph.Create("blur", half);
+                m_Graph.AddPass("blur", [=](RenderGraph::Builder& builder) { builder.Read(source); builder.Write(blurred); },
+                    [=, this, &renderer](const RenderGraph::Context& context) {
+                        const RenderTargetDescription& description = context.GetDescription(source);
+                        context.Bind(source, 0);
+                        m_Blur.Bind();
+                        m_Blur.SetUniform(m_BlurDirection, axis / glm::vec2(description.Width, description.Height));
+                        renderer.DrawFullscreen(m_Blur);
+                    });
+                bloom = blurred;
+            }
+        }
+
+        const ResourceID debug = m_Graph.Create("debug", half);
+        m_Graph.AddPass("debug", [=](RenderGraph::Builder& builder) { builder.Read(bloom); builder.Write(debug); },
+            [=, this, &renderer](const RenderGraph::Context& context) {
+                context.Bind(bloom, 0);
+                renderer.DrawFullscreen(m_Blur);
+            });
+
+        m_Graph.AddPass("composite", [=](RenderGraph::Builder& builder) {
+                builder.Read(scene);
+                builder.Read(bloom);
+                builder.Write(output);
+            },
+            [=, this, &renderer](const RenderGraph::Context& context) {
+                context.Bind(scene, 0);
+                context.Bind(bloom, 1);
+                renderer.DrawFullscreen(m_Composite);
+            });
+
+        if (!m_Graph.Compile())
+            m_Error = "render graph passes form a cycle";
+        // Fullscreen passes replace what is there
+        GLCall(glDisable(GL_BLEND));
+        m_Graph.Execute();
+        GLCall(glEnable(GL_BLEND));
+
+        if (!m_Checked) {
+            m_Checked = true;
+            CheckOutput(output);
+        }
+    }
+
+    std::string GetError() const override { return m_Error; }
+
+private:
+    // Bloom only ever adds light, so every channel under the last quad drawn,
+    // which nothing covers, is at least its color, and the composite is opaque
+    void CheckOutput(RenderGraph::ResourceID output) {
+        std::vector<unsigned char> pixels;
+        if (!m_Graph.ReadPixels(output, pixels) || pixels.size() != static_cast<size_t>(m_Width) * m_Height * 4) {
+            m_Error = "failed to read back the output";
+            return;
+        }
+        if (m_Positions.empty())
+            return;
+
+        const int x = std::clamp(static_cast<int>(m_Positions.back().x), 0, m_Width - 1);
+        const int y = std::clamp(static_cast<int>(m_Positions.back().y), 0, m_Height - 1);
+        const unsigned char* pixel = &pixels[(static_cast<size_t>(y) * m_Width + x) * 4];
+        for (int channel = 0; channel < 3; channel++) {
+            if (pixel[channel] + 2 < static_cast<int>(m_Colors.back()[channel] * 255.0f))
+                m_Error = "output is darker than the scene at (" + std::to_string(x) + ", " + std::to_string(y) + ")";
+        }
+        if (pixel[3] != 255)
+            m_Error = "output is not opaque at (" + std::to_string(x) + ", " + std::to_string(y) + ")";
+    }
+};
+
+// Small static polygons baked in world space, a few replaced every frame.
+// "meshes" gives each one its own buffers and vertex array and draws them one
+// by one; "meshpool" suballocates them from a MeshPool and draws all of them
+// with one multi-draw.
+class MeshScene : public BenchmarkScene {
+private:
+    static constexpr int ReplacedPerFrame = 16;
+
+    struct SeparateMesh {
+        VertexArray Vertices;
+        VertexBuffer VertexData;
+        IndexBuffer Indices;
+    };
+
+    struct Geometry {
+        std::vector<float> Vertices;
+        std::vector<unsigned int> Indices;
+    };
+
+    std::vector<Geometry> m_Geometry;
+    std::vector<SeparateMesh> m_SeparateMeshes;
+    std::vector<MeshHandle> m_PooledMeshes;
+    std::unique_ptr<MeshPool> m_Pool;
+    VertexBufferLayout m_Layout;
+    Shader m_Shader;
+    Texture m_Texture;
+    size_t m_NextReplaced = 0;
+    bool m_Pooled;
+public:
+    MeshScene(int count, int width, int height, bool pooled)
+        : m_Shader("res/shaders/Basic.shader"), m_Texture(1, 1, std::vector<unsigned char>{ 255, 255, 255, 255 }.data()),
+          m_Pooled(pooled) {
+        m_Layout.Push<float>(2);
+        m_Layout.Push<float>(2);
+        m_Shader.Bind();
+        m_Shader.SetUniform1i("u_Texture", 0);
+        m_Shader.SetUniformMat4f("u_Model", glm::mat4(1.0f));
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width));
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height));
+        for (int i = 0; i < count; i++) {
+            // Fans of 3 to 8 sides
+            const unsigned int sides = 3 + i % 6;
+            const glm::vec2 center(x(random), y(random));
+            Geometry geometry;
+            for (unsigned int side = 0; side < sides; side++) {
+                const float angle = side * 6.2831853f / sides;
+                geometry.Vertices.insert(geometry.Vertices.end(),
+                    { center.x + std::cos(angle) * 4.0f, center.y + std::sin(angle) * 4.0f, 0.5f + std::cos(angle) * 0.5f, 0.5f + std::sin(angle) * 0.5f });
+                if (side >= 2)
+                    geometry.Indices.insert(geometry.Indices.end(), { 0, side - 1, side });
+            }
+            m_Geometry.push_back(std::move(geometry));
+        }
+
+        // Starts small so loading exercises growth
+        if (m_Pooled)
+            m_Pool = std::make_unique<MeshPool>(m_Layout, 1024, 1024);
+        for (size_t i = 0; i < m_Geometry.size(); i++) {
+            if (m_Pooled)
+                m_PooledMeshes.push_back(AddPooled(m_Geometry[i]));
+            else
+                m_SeparateMeshes.push_back(CreateSeparate(m_Geometry[i]));
+        }
+    }
+
+    const char* GetName() const override { return m_Pooled ? "meshpool" : "meshes"; }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        for (int i = 0; i < ReplacedPerFrame && !m_Geometry.empty(); i++) {
+            const size_t index = m_NextReplaced++ % m_Geometry.size();
+            if (m_Pooled) {
+                m_Pool->Remove(m_PooledMeshes[index]);
+                m_PooledMeshes[index] = AddPooled(m_Geometry[index]);
+            } else {
+                m_SeparateMeshes[index] = CreateSeparate(m_Geometry[index]);
+            }
+        }
+
+        m_Texture.Bind();
+        if (m_Pooled) {
+            m_Pool->ResetStats();
+            m_Pool->DrawMulti(m_PooledMeshes.data(), m_PooledMeshes.size(), m_Shader);
+        } else {
+            for (const SeparateMesh& mesh : m_SeparateMeshes)
+                renderer.Draw(mesh.Vertices, mesh.Indices, m_Shader);
+        }
+    }
+
+    unsigned int GetDrawCalls() const override { return m_Pooled ? m_Pool->GetStats().DrawCalls : 0; }
+
+private:
+    MeshHandle AddPooled(const Geometry& geometry) {
+        return m_Pool->Add(geometry.Vertices.data(), static_cast<unsigned int>(geometry.Vertices.size() / 4),
+                           geometry.Indices.data(), static_cast<unsigned int>(geometry.Indices.size()));
+    }
+
+    SeparateMesh CreateSeparate(const Geometry& geometry) {
+        SeparateMesh mesh{ VertexArray(),
+                           VertexBuffer(geometry.Vertices.data(), static_cast<unsigned int>(geometry.Vertices.size() * sizeof(float))),
+                           IndexBuffer(geometry.Indices.data(), static_cast<unsigned int>(geometry.Indices.size())) };
+        mesh.Vertices.AddBuffer(mesh.VertexData, m_Layout);
+        return mesh;
+    }
+};
+
+// A grid written as OBJ, converted once and then streamed through the
+// MeshLoader over and over: each frame uploads what the worker has mapped
+// within a small budget and draws what has arrived, and a finished mesh is
+// dropped and requested again. Count is the grid's cells per side.
+class MeshStreamScene : public BenchmarkScene {
+private:
+    static constexpr int RowsPerGroup = 64;
+
+    std::filesystem::path m_ObjPath;
+    std::filesystem::path m_MeshPath;
+    bool m_Converted = false;
+    bool m_Failed = false;
+    MeshLoader m_Loader;
+    std::shared_ptr<Mesh> m_Mesh;
+    Shader m_Shader;
+    Texture m_Texture;
+public:
+    MeshStreamScene(int count, int width, int height)
+        : m_ObjPath(std::filesystem::temp_directory_path() / "ModernOpenGLBenchmark_grid.obj"),
+          m_MeshPath(std::filesystem::temp_directory_path() / "ModernOpenGLBenchmark_grid.mesh"),
+          m_Shader("res/shaders/Basic.shader"), m_Texture(1, 1, std::vector<unsigned char>{ 255, 255, 255, 255 }.data()) {
+        m_Shader.Bind();
+        m_Shader.SetUniform1i("u_Texture", 0);
+        m_Shader.SetUniformMat4f("u_Model", glm::mat4(1.0f));
+
+        {
+            // One group per band of rows, so the mesh streams as several chunks
+            std::ofstream obj(m_ObjPath);
+            for (int y = 0; y <= count; y++) {
+                for (int x = 0; x <= count; x++) {
+                    obj << "v " << x * static_cast<float>(width) / count << ' ' << y * static_cast<float>(height) / count << " 0\n"
+                        << "vt " << static_cast<float>(x) / count << ' ' << static_cast<float>(y) / count << '\n';
+                }
+            }
+            for (int y = 0; y < count; y++) {
+                if (y % RowsPerGroup == 0)
+                    obj << "g rows" << y << '\n';
+                for (int x = 0; x < count; x++) {
+                    const int corner = y * (count + 1) + x + 1;
+                    obj << "f " << corner << '/' << corner << ' ' << corner + 1 << '/' << corner + 1 << ' '
+                        << corner + count + 2 << '/' << corner + count + 2 << ' ' << corner + count + 1 << '/' << corner + count + 1 << '\n';
+                }
+            }
+        }
+        const MeshData data = MeshData::ImportObj(m_ObjPath.string());
+        m_Converted = data.IsValid() && data.Save(m_MeshPath.string());
+        if (m_Converted)
+            m_Mesh = m_Loader.Load(m_MeshPath.string());
+    }
+
+    ~MeshStreamScene() override {
+        std::error_code error;
+        std::filesystem::remove(m_ObjPath, error);
+        std::filesystem::remove(m_MeshPath, error);
+    }
+
+    const char* GetName() const override { return "meshstream"; }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        m_Loader.ProcessUploads(2.0, 4 * 1024 * 1024);
+        m_Texture.Bind();
+        m_Mesh->Draw(renderer, m_Shader);
+
+        if (m_Mesh->IsLoaded()) {
+            // A finished load with no chunks means the file was rejected
+            if (m_Mesh->GetChunkCount() == 0)
+                m_Failed = true;
+            m_Mesh.reset();
+            m_Mesh = m_Loader.Load(m_MeshPath.string());
+        }
+    }
+
+    std::string GetError() const override {
+        if (!m_Converted)
+            return "failed to convert '" + m_ObjPath.generic_string() + "'";
+        return m_Failed ? "failed to stream '" + m_MeshPath.generic_string() + "'" : std::string();
+    }
+};
+
+// Polygon meshes from a MeshPool placed over a world four screens wide and
+// tall under a panning camera, in four materials. "indirect" culls and draws
+// on the best path the context has, one multi-draw per material;
+// "indirect_cpu" forces the GL 3.3 path with a draw per visible mesh.
+class IndirectScene : public BenchmarkScene {
+private:
+    static constexpr int MaterialCount = 4;
+    static constexpr int ShapeCount = 6;
+
+    struct Object {
+        MeshHandle Mesh;
+        int Material;
+        glm::mat4 Model;
+    };
+
+    VertexBufferLayout m_Layout;
+    std::unique_ptr<MeshPool> m_Pool;
+    std::unique_ptr<IndirectRenderer> m_Indirect;
+    std::vector<MeshHandle> m_Shapes;
+    std::vector<Object> m_Objects;
+    std::vector<Texture> m_Textures;
+    Shader m_Shader;
+    AABB m_ShapeBounds{ glm::vec3(-4.0f, -4.0f, 0.0f), glm::vec3(4.0f, 4.0f, 0.0f) };
+    glm::mat4 m_Projection;
+    float m_WorldWidth;
+    float m_WorldHeight;
+    int m_Frame = 0;
+    bool m_ForceFallback;
+public:
+    IndirectScene(int count, int width, int height, bool forceFallback)
+        : m_Shader("res/shaders/Instanced.shader"),
+          m_Projection(glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height), -1.0f, 1.0f)),
+          m_WorldWidth(width * 4.0f), m_WorldHeight(height * 4.0f), m_ForceFallback(forceFallback) {
+        // Shapes are small around their origin, so half positions lose nothing visible
+        m_Layout.Push<HalfFloat>(2);
+        m_Layout.Push<NormalizedUShort>(2);
+        m_Shader.Bind();
+        m_Shader.SetUniform1i("u_Texture", 0);
+
+        m_Pool = std::make_unique<MeshPool>(m_Layout, 1024, 1024);
+        m_Indirect = std::make_unique<IndirectRenderer>(*m_Pool, count);
+        if (forceFallback)
+            m_Indirect->SetPath(IndirectRenderer::Path::CpuFallback);
+
+        // Fans of 3 to 8 sides around the origin
+        for (unsigned int sides = 3; sides < 3 + ShapeCount; sides++) {
+            std::vector<float> positions;
+            std::vector<float> texCoords;
+            std::vector<unsigned int> indices;
+            for (unsigned int side = 0; side < sides; side++) {
+                const float angle = side * 6.2831853f / sides;
+                positions.insert(positions.end(), { std::cos(angle) * 4.0f, std::sin(angle) * 4.0f });
+                texCoords.insert(texCoords.end(), { 0.5f + std::cos(angle) * 0.5f, 0.5f + std::sin(angle) * 0.5f });
+                if (side >= 2)
+                    indices.insert(indices.end(), { 0, side - 1, side });
+            }
+            std::vector<unsigned char> vertices(sides * m_Layout.GetStride());
+            VertexPacking::PackHalf(positions.data(), sides, 2, vertices.data(), m_Layout.GetStride());
+            VertexPacking::PackNormalizedUShort(texCoords.data(), sides, 2, vertices.data() + 2 * sizeof(HalfFloat), m_Layout.GetStride());
+            m_Shapes.push_back(m_Pool->Add(vertices.data(), sides, indices.data(), static_cast<unsigned int>(indices.size())));
+        }
+
+        const unsigned char colors[MaterialCount][4] = { { 255, 64, 64, 255 }, { 64, 255, 64, 255 }, { 64, 64, 255, 255 }, { 255, 255, 64, 255 } };
+        for (const auto& color : colors)
+            m_Textures.emplace_back(1, 1, color);
+
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> x(0.0f, m_WorldWidth);
+        std::uniform_real_distribution<float> y(0.0f, m_WorldHeight);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        for (int i = 0; i < count; i++) {
+            const glm::mat4 model = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(x(random), y(random), 0.0f)),
+                                                angle(random), glm::vec3(0.0f, 0.0f, 1.0f));
+            m_Objects.push_back({ m_Shapes[i % ShapeCount], (i / ShapeCount) % MaterialCount, model });
+        }
+    }
+
+    // "indirect" keeps its name when the context only allows the fallback;
+    // the path field says which one ran
+    const char* GetName() const override { return m_ForceFallback ? "indirect_cpu" : "indirect"; }
+
+    const char* GetPath() const override {
+        switch (m_Indirect->GetPath()) {
+            case IndirectRenderer::Path::GpuDriven:   return "gpu";
+            case IndirectRenderer::Path::CpuIndirect: return "cpu_indirect";
+            case IndirectRenderer::Path::CpuFallback: return "cpu_fallback";
+        }
+        return nullptr;
+    }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        m_Frame++;
+        const glm::vec3 camera(std::fmod(m_Frame * 4.0f, m_WorldWidth * 0.75f), std::fmod(m_Frame * 2.0f, m_WorldHeight * 0.75f), 0.0f);
+        const glm::mat4 view = glm::translate(glm::mat4(1.0f), -camera);
+        renderer.BeginFrame(view, m_Projection, m_Frame / 60.0f, 1.0f / 60.0f);
+
+        for (const Object& object : m_Objects)
+            m_Indirect->Submit(object.Mesh, m_Shader, &m_Textures[object.Material], object.Model, m_ShapeBounds);
+        m_Indirect->Flush(m_Projection * view);
+    }
+
+    unsigned int GetDrawCalls() const override { return m_Indirect->GetStats().DrawCalls; }
+};
+
+// A fountain kept at count live particles: the dead are replaced every
+// frame, the update runs on the render thread and the instance data is
+// written straight into the streamed buffer
+class ParticleScene : public BenchmarkScene {
+private:
+    ParticleSystem m_Particles;
+    ParticleRenderer m_ParticleRenderer;
+    ParticleEmitDescription m_Emitter;
+public:
+    ParticleScene(int count, int width, int height)
+        : m_Particles(count), m_ParticleRenderer(count) {
+        m_Emitter.Position = glm::vec3(width * 0.5f, height * 0.1f, 0.0f);
+        m_Emitter.PositionSpread = glm::vec3(8.0f, 8.0f, 0.0f);
+        m_Emitter.Velocity = glm::vec3(0.0f, height * 0.9f, 0.0f);
+        m_Emitter.VelocitySpread = glm::vec3(width * 0.15f, height * 0.2f, 0.0f);
+        m_Emitter.Lifetime = 1.5f;
+        m_Emitter.LifetimeSpread = 0.5f;
+        m_Particles.SetGravity(glm::vec3(0.0f, -height * 0.6f, 0.0f));
+        m_Particles.SetRamp({ glm::vec4(1.0f, 0.8f, 0.3f, 1.0f), glm::vec4(0.8f, 0.1f, 0.0f, 0.0f), 6.0f, 2.0f });
+        m_Particles.Emit(m_Emitter, count);
+    }
+
+    const char* GetName() const override { return "particles"; }
+
+    void Render(Renderer& renderer, BatchRenderer&) override {
+        m_Particles.Update(1.0f / 60.0f);
+        m_Particles.Emit(m_Emitter, m_Particles.GetCapacity() - m_Particles.GetCount());
+        m_ParticleRenderer.Draw(renderer, m_Particles);
+    }
+};
+
+// GL_TIME_ELAPSED queries read back a few frames late so the CPU never waits on them
+class GpuTimer {
+private:
+    static constexpr unsigned int QueryCount = 4;
+    unsigned int m_Queries[QueryCount]{};
+    unsigned int m_Frame = 0;
+    std::vector<double> m_Results;
+public:
+    GpuTimer() {
+        GLCall(glGenQueries(QueryCount, m_Queries));
+    }
+
+    ~GpuTimer() {
+        GLCall(glDeleteQueries(QueryCount, m_Queries));
+    }
+
+    void Begin() {
+        if (m_Frame >= QueryCount)
+            Collect(m_Queries[m_Frame % QueryCount]);
+        GLCall(glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_Frame % QueryCount]));
+    }
+
+    void End() {
+        GLCall(glEndQuery(GL_TIME_ELAPSED));
+        m_Frame++;
+    }
+
+    // Waits for the queries still in flight
+    const std::vector<double>& Finish() {
+        const unsigned int pending = std::min(m_Frame, QueryCount);
+        for (unsigned int i = m_Frame - pending; i < m_Frame; i++)
+            Collect(m_Queries[i % QueryCount]);
+        m_Frame = 0;
+        return m_Results;
+    }
+
+    void Reset() {
+        Finish();
+        m_Results.clear();
+    }
+
+private:
+    void Collect(unsigned int query) {
+        GLuint64 nanoseconds = 0;
+        GLCall(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds));
+        m_Results.push_back(nanoseconds / 1.0e6);
+    }
+};
+
+struct SceneEntry {
+    const char* Name;
+    int DefaultCount;
+    std::unique_ptr<BenchmarkScene> (*Create)(int count, int width, int height);
+};
+
+static const SceneEntry s_Scenes[] = {
+    { "quads", 10000, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<QuadScene>(count, width, height); } },
+    { "textures", 256, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<TextureScene>(count, width, height); } },
+    { "shaders", 64, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<ShaderScene>(count, width, height); } },
+    { "transforms", 65536, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<TransformScene>(count, width, height); } },
+    { "unsorted", 4096, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<MixedScene>(count, width, height, MixedScene::Mode::Unsorted); } },
+    { "queue", 4096, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<MixedScene>(count, width, height, MixedScene::Mode::Queue); } },
+    { "jobs", 4096, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<MixedScene>(count, width, height, MixedScene::Mode::Jobs); } },
+    { "world", 100000, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<WorldScene>(count, width, height, false); } },
+    { "culling", 100000, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<WorldScene>(count, width, height, true); } },
+    { "text", 2000, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<TextScene>(count, width, height); } },
+    { "postprocess", 10000, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<PostProcessScene>(count, width, height); } },
+    { "meshes", 4096, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<MeshScene>(count, width, height, false); } },
+    { "meshpool", 4096, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<MeshScene>(count, width, height, true); } },
+    { "meshstream", 256, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<MeshStreamScene>(count, width, height); } },
+    { "indirect", 16384, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<IndirectScene>(count, width, height, false); } },
+    { "indirect_cpu", 16384, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<IndirectScene>(count, width, height, true); } },
+    { "particles", 200000, [](int count, int width, int height) -> std::unique_ptr<BenchmarkScene> {
+        return std::make_unique<ParticleScene>(count, width, height); } },
+};
+
+static double Percentile(std::vector<double> values, double percentile) {
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    const size_t index = static_cast<size_t>(percentile / 100.0 * (values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+static std::string TimingsToJson(const std::vector<double>& values) {
+    double sum = 0.0;
+    for (const double value : values)
+        sum += value;
+
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), "{ \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f }",
+                  values.empty() ? 0.0 : sum / values.size(), Percentile(values, 50.0), Percentile(values, 90.0),
+                  Percentile(values, 99.0), Percentile(values, 100.0));
+    return buffer;
+}
+
+static std::string RunScene(BenchmarkScene& scene, int count, const BenchmarkOptions& options,
+                            Framebuffer& framebuffer, Renderer& renderer, BatchRenderer& batch) {
+    if (const std::string error = scene.GetError(); !error.empty()) {
+        s_Failed = true;
+        return "    {\n      \"scene\": \"" + std::string(scene.GetName()) + "\",\n      \"error\": \"" + error + "\"\n    }";
+    }
+
+    const glm::mat4 proj = glm::ortho(0.0f, static_cast<float>(options.Width), 0.0f, static_cast<float>(options.Height), -1.0f, 1.0f);
+    const glm::mat4 view(1.0f);
+
+    GpuTimer gpuTimer;
+    std::vector<double> cpuTimes;
+    cpuTimes.reserve(options.Frames);
+    FrameCounters counters;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < options.Warmup + options.Frames; frame++) {
+        if (frame == options.Warmup) {
+            gpuTimer.Reset();
+            counters = {};
+        }
+
+        const auto frameStart = std::chrono::steady_clock::now();
+#if PROFILING
+        Profiler::BeginFrame();
+#endif
+        GLStateCache::ResetStats();
+        renderer.ResetStats();
+        batch.ResetStats();
+
+        gpuTimer.Begin();
+        framebuffer.Bind();
+        renderer.BeginFrame(view, proj, frame / 60.0f, 1.0f / 60.0f);
+        renderer.Clear();
+        scene.Render(renderer, batch);
+        gpuTimer.End();
+        GLCall(glFlush());
+#if PROFILING
+        Profiler::EndFrame();
+#endif
+
+        const auto frameEnd = std::chrono::steady_clock::now();
+        if (frame >= options.Warmup) {
+            cpuTimes.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+            counters.DrawCalls += renderer.GetStats().DrawCalls + batch.GetStats().DrawCalls + scene.GetDrawCalls();
+            counters.BindsIssued += GLStateCache::GetStats().Issued;
+            counters.BindsSkipped += GLStateCache::GetStats().Skipped;
+        }
+    }
+    const std::vector<double>& gpuTimes = gpuTimer.Finish();
+    GLCall(glFinish());
+    const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const double frames = std::max(1, options.Frames);
+    std::ostringstream json;
+    json << "    {\n"
+         << "      \"scene\": \"" << scene.GetName() << "\",\n"
+         << "      \"count\": " << count << ",\n";
+    if (const char* path = scene.GetPath())
+        json << "      \"path\": \"" << path << "\",\n";
+    json << "      \"frames\": " << options.Frames << ",\n"
+         << "      \"total_ms\": " << totalMs << ",\n"
+         << "      \"cpu_ms\": " << TimingsToJson(cpuTimes) << ",\n"
+         << "      \"gpu_ms\": " << TimingsToJson(gpuTimes) << ",\n"
+         << "      \"draw_calls_per_frame\": " << counters.DrawCalls / frames << ",\n"
+         << "      \"binds_issued_per_frame\": " << counters.BindsIssued / frames << ",\n"
+         << "      \"binds_skipped_per_frame\": " << counters.BindsSkipped / frames;
+    // Some scenes only find out while running, e.g. from what they read back
+    if (const std::string error = scene.GetError(); !error.empty()) {
+        s_Failed = true;
+        json << ",\n      \"error\": \"" << error << "\"";
+    }
+    json << "\n    }";
+    return json.str();
+}
+
+// Steady-state particle frames on the CPU alone: refill, update (integration
+// and compaction) and the vertex writes a draw would do, into plain memory
+static std::string RunParticleKernels(const char* name, int count, const BenchmarkOptions& options, bool threaded) {
+    const std::unique_ptr<JobSystem> jobs = threaded ? std::make_unique<JobSystem>() : nullptr;
+    ParticleSystem particles(count);
+    particles.SetGravity(glm::vec3(0.0f, -9.8f, 0.0f));
+    particles.SetDrag(0.1f);
+    particles.SetRamp({ glm::vec4(1.0f, 0.8f, 0.3f, 1.0f), glm::vec4(0.8f, 0.1f, 0.0f, 0.0f), 0.2f, 0.05f });
+    ParticleEmitDescription emitter;
+    emitter.PositionSpread = glm::vec3(1.0f);
+    emitter.Velocity = glm::vec3(0.0f, 10.0f, 0.0f);
+    emitter.VelocitySpread = glm::vec3(3.0f);
+    emitter.Lifetime = 1.5f;
+    emitter.LifetimeSpread = 0.5f;
+    std::vector<ParticleVertex> vertices(count);
+
+    std::vector<double> updateTimes, writeTimes;
+    updateTimes.reserve(options.Frames);
+    writeTimes.reserve(options.Frames);
+    uint64_t updated = 0;
+    for (int frame = 0; frame < options.Warmup + options.Frames; frame++) {
+        particles.Emit(emitter, particles.GetCapacity() - particles.GetCount());
+        const size_t live = particles.GetCount();
+
+        const auto updateStart = std::chrono::steady_clock::now();
+        particles.Update(1.0f / 60.0f, jobs.get());
+        const auto writeStart = std::chrono::steady_clock::now();
+        particles.WriteVertices(vertices.data(), SIZE_MAX, jobs.get());
+        const auto writeEnd = std::chrono::steady_clock::now();
+
+        if (frame >= options.Warmup) {
+            updateTimes.push_back(std::chrono::duration<double, std::milli>(writeStart - updateStart).count());
+            writeTimes.push_back(std::chrono::duration<double, std::milli>(writeEnd - writeStart).count());
+            updated += live;
+        }
+    }
+
+    double updateTotal = 0.0, writeTotal = 0.0;
+    for (size_t i = 0; i < updateTimes.size(); i++) {
+        updateTotal += updateTimes[i];
+        writeTotal += writeTimes[i];
+    }
+    std::ostringstream json;
+    json << "    {\n"
+         << "      \"scene\": \"" << name << "\",\n"
+         << "      \"count\": " << count << ",\n"
+         << "      \"frames\": " << options.Frames << ",\n"
+         << "      \"threads\": " << (jobs ? jobs->GetThreadCount() : 1) << ",\n"
+         << "      \"update_ms\": " << TimingsToJson(updateTimes) << ",\n"
+         << "      \"write_ms\": " << TimingsToJson(writeTimes) << ",\n"
+         << "      \"update_particles_per_second\": " << (updateTotal > 0.0 ? updated / (updateTotal / 1000.0) : 0.0) << ",\n"
+         << "      \"write_particles_per_second\": " << (writeTotal > 0.0 ? updated / (writeTotal / 1000.0) : 0.0) << ",\n"
+         << "      \"killed_per_frame\": " << particles.GetStats().Killed / static_cast<double>(options.Warmup + options.Frames) << "\n"
+         << "    }";
+    return json.str();
+}
+
+static std::string PackingMismatch(const char* format, float value, unsigned int simd, unsigned int scalar) {
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "%s of %g packs to 0x%x in bulk but 0x%x on its own", format, value, simd, scalar);
+    return buffer;
+}
+
+// The bulk packers convert eight (or four vectors) at a time with SIMD and
+// the rest one by one; both have to agree bit for bit on the values where
+// rounding and clamping are easiest to get wrong, and on random bit patterns
+static std::string CheckPacking() {
+    const float infinity = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> values = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 1.0e6f, -1.0e6f, infinity, -infinity, nan, -nan,
+        // Largest half, the last value rounding down to it and the first rounding to infinity
+        65504.0f, -65504.0f, 65519.996f, 65520.0f, -65520.0f,
+        // Float subnormals, the smallest half subnormal, ties between half subnormals and the smallest normal half
+        1.0e-40f, -1.0e-40f, 5.9604645e-8f, 2.9802322e-8f, 8.9406967e-8f, 6.0975552e-5f, 6.1035156e-5f,
+        // Ties between adjacent normal halves round to even
+        1.00048828125f, 1.00146484375f, -1.00048828125f, 2049.0f, 2051.0f,
+        // Just outside the normalized ranges, and ties between their steps
+        1.0000001f, -1.0000001f, 0.99999994f, 0.5f / 32767.0f, 1.5f / 32767.0f, -0.5f / 32767.0f,
+        0.5f / 65535.0f, 1.5f / 65535.0f, 0.5f / 511.0f, 1.5f / 511.0f,
+    };
+    std::mt19937 random(1234);
+    for (int i = 0; i < 4096; i++) {
+        float value;
+        const uint32_t bits = random();
+        std::memcpy(&value, &bits, sizeof(value));
+        // NaN payloads are not part of the format
+        values.push_back(std::isnan(value) ? std::copysign(nan, value) : value);
+    }
+    // Whole groups of four 4-component normals, so every value takes the SIMD path
+    values.resize((values.size() + 15) / 16 * 16, 0.0f);
+
+    std::vector<uint16_t> packed(values.size());
+    VertexPacking::PackHalf(values.data(), values.size(), 1, packed.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        if (const uint16_t scalar = VertexPacking::ToHalf(values[i]).Bits; packed[i] != scalar)
+            return PackingMismatch("half", values[i], packed[i], scalar);
+    }
+    VertexPacking::PackNormalizedShort(values.data(), values.size(), 1, packed.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        if (const auto scalar = static_cast<uint16_t>(VertexPacking::ToNormalizedShort(values[i]).Value); packed[i] != scalar)
+            return PackingMismatch("normalized short", values[i], packed[i], scalar);
+    }
+    VertexPacking::PackNormalizedUShort(values.data(), values.size(), 1, packed.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        if (const uint16_t scalar = VertexPacking::ToNormalizedUShort(values[i]).Value; packed[i] != scalar)
+            return PackingMismatch("normalized ushort", values[i], packed[i], scalar);
+    }
+
+    std::vector<uint32_t> normals(values.size() / 3);
+    for (const unsigned int components : { 4u, 3u }) {
+        const size_t count = values.size() / components / 4 * 4;
+        VertexPacking::PackNormals(values.data(), count, components, normals.data());
+        for (size_t i = 0; i < count; i++) {
+            const float* v = &values[i * components];
+            const uint32_t scalar = VertexPacking::ToPackedNormal({ v[0], v[1], v[2], components == 4 ? v[3] : 0.0f }).Bits;
+            if (normals[i] != scalar)
+                return PackingMismatch("normal", v[0], normals[i], scalar);
+        }
+    }
+    return {};
+}
+
+// Packs texture coordinates to halves and normals to 2_10_10_10 into an
+// interleaved buffer, as a mesh import does, once the bulk paths check out
+static std::string RunPackingKernels(const char* name, int count, const BenchmarkOptions& options) {
+    if (const std::string error = CheckPacking(); !error.empty()) {
+        s_Failed = true;
+        return "    {\n      \"scene\": \"" + std::string(name) + "\",\n      \"error\": \"" + error + "\"\n    }";
+    }
+
+    struct PackedVertex {
+        HalfFloat TexCoord[2];
+        PackedNormal Normal;
+    };
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<float> texCoords(static_cast<size_t>(count) * 2);
+    std::vector<float> normals(static_cast<size_t>(count) * 3);
+    for (float& value : texCoords)
+        value = unit(random) * 4.0f;
+    for (float& value : normals)
+        value = unit(random);
+    std::vector<PackedVertex> vertices(count);
+
+    std::vector<double> halfTimes, normalTimes;
+    halfTimes.reserve(options.Frames);
+    normalTimes.reserve(options.Frames);
+    for (int frame = 0; frame < options.Warmup + options.Frames; frame++) {
+        const auto halfStart = std::chrono::steady_clock::now();
+        VertexPacking::PackHalf(texCoords.data(), count, 2, &vertices[0].TexCoord, sizeof(PackedVertex));
+        const auto normalStart = std::chrono::steady_clock::now();
+        VertexPacking::PackNormals(normals.data(), count, 3, &vertices[0].Normal, sizeof(PackedVertex));
+        const auto normalEnd = std::chrono::steady_clock::now();
+
+        if (frame >= options.Warmup) {
+            halfTimes.push_back(std::chrono::duration<double, std::milli>(normalStart - halfStart).count());
+            normalTimes.push_back(std::chrono::duration<double, std::milli>(normalEnd - normalStart).count());
+        }
+    }
+
+    double total = 0.0;
+    for (size_t i = 0; i < halfTimes.size(); i++)
+        total += halfTimes[i] + normalTimes[i];
+    std::ostringstream json;
+    json << "    {\n"
+         << "      \"scene\": \"" << name << "\",\n"
+         << "      \"count\": " << count << ",\n"
+         << "      \"frames\": " << options.Frames << ",\n"
+         << "      \"half_ms\": " << TimingsToJson(halfTimes) << ",\n"
+         << "      \"normal_ms\": " << TimingsToJson(normalTimes) << ",\n"
+         << "      \"vertices_per_second\": " << (total > 0.0 ? count * static_cast<double>(halfTimes.size()) / (total / 1000.0) : 0.0) << "\n"
+         << "    }";
+    return json.str();
+}
+
+// Benchmarks that need no GL context, run with --cpu
+struct KernelEntry {
+    const char* Name;
+    int DefaultCount;
+    std::string (*Run)(const char* name, int count, const BenchmarkOptions& options);
+};
+
+static const KernelEntry s_Kernels[] = {
+    { "particles_update", 1000000, [](const char* name, int count, const BenchmarkOptions& options) {
+        return RunParticleKernels(name, count, options, false); } },
+    { "particles_jobs", 1000000, [](const char* name, int count, const BenchmarkOptions& options) {
+        return RunParticleKernels(name, count, options, true); } },
+    { "packing", 1000000, [](const char* name, int count, const BenchmarkOptions& options) {
+        return RunPackingKernels(name, count, options); } },
+};
+
+static bool ParseArguments(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--window")
+            options.Headless = false;
+        else if (argument == "--cpu")
+            options.CpuOnly = true;
+        else if (argument == "--scene" && hasValue)
+            options.Scene = argv[++i];
+        else if (argument == "--count" && hasValue)
+            options.Count = std::atoi(argv[++i]);
+        else if (argument == "--frames" && hasValue)
+            options.Frames = std::atoi(argv[++i]);
+        else if (argument == "--warmup" && hasValue)
+            options.Warmup = std::atoi(argv[++i]);
+        else if (argument == "--width" && hasValue)
+            options.Width = std::atoi(argv[++i]);
+        else if (argument == "--height" && hasValue)
+            options.Height = std::atoi(argv[++i]);
+        else if (argument == "--font" && hasValue)
+            options.Font = argv[++i];
+        else if (argument == "--output" && hasValue)
+            options.Output = argv[++i];
+        else if (argument == "--trace" && hasValue)
+            options.Trace = argv[++i];
+        else {
+            std::cerr << "Unknown argument '" << argument << "'" << std::endl;
+            return false;
+        }
+    }
+    const bool known = options.CpuOnly
+        ? std::any_of(std::begin(s_Kernels), std::end(s_Kernels), [&](const KernelEntry& entry) { return options.Scene == entry.Name; })
+        : std::any_of(std::begin(s_Scenes), std::end(s_Scenes), [&](const SceneEntry& entry) { return options.Scene == entry.Name; });
+    if (options.Scene != "all" && !known) {
+        std::cerr << "Unknown scene '" << options.Scene << "'" << std::endl;
+        return false;
+    }
+    return options.Frames > 0 && options.Width > 0 && options.Height > 0;
+}
+
+static void RunKernels(const BenchmarkOptions& options, std::ostringstream& json) {
+    json << "{\n"
+         << "  \"renderer\": \"none\",\n"
+         << "  \"results\": [\n";
+
+    bool first = true;
+    for (const KernelEntry& entry : s_Kernels) {
+        if (options.Scene != "all" && options.Scene != entry.Name)
+            continue;
+
+        const int count = options.Count > 0 ? options.Count : entry.DefaultCount;
+        json << (first ? "" : ",\n") << entry.Run(entry.Name, count, options);
+        first = false;
+    }
+    json << "\n  ]\n}\n";
+}
+
+static bool RunScenes(const BenchmarkOptions& options, std::ostringstream& json) {
+    Window window({ "Benchmark", options.Width, options.Height, false, options.Headless });
+    if (!window.IsValid())
+        return false;
+
+    GLCall(glEnable(GL_BLEND));
+    GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+    Framebuffer framebuffer({ options.Width, options.Height });
+    s_Framebuffer = &framebuffer;
+    Renderer renderer;
+    BatchRenderer batch;
+
+    json << "{\n"
+         << "  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"version\": \"" << glGetString(GL_VERSION) << "\",\n"
+         << "  \"width\": " << options.Width << ",\n"
+         << "  \"height\": " << options.Height << ",\n"
+         << "  \"results\": [\n";
+
+    bool first = true;
+    for (const SceneEntry& entry : s_Scenes) {
+        if (options.Scene != "all" && options.Scene != entry.Name)
+            continue;
+
+        const int count = options.Count > 0 ? options.Count : entry.DefaultCount;
+        const std::unique_ptr<BenchmarkScene> scene = entry.Create(count, options.Width, options.Height);
+        json << (first ? "" : ",\n") << RunScene(*scene, count, options, framebuffer, renderer, batch);
+        first = false;
+    }
+    json << "\n  ]\n}\n";
+
+    if (!options.Trace.empty()) {
+#if PROFILING
+        if (!Profiler::ExportChromeTrace(options.Trace))
+            std::cerr << "Failed to write trace '" << options.Trace << "'" << std::endl;
+#else
+        std::cerr << "--trace needs a build with MODERNOPENGL_PROFILING" << std::endl;
+#endif
+    }
+
+    framebuffer.Unbind();
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!ParseArguments(argc, argv, options))
+        return 1;
+    s_FontPath = options.Font;
+
+    std::ostringstream json;
+    if (options.CpuOnly)
+        RunKernels(options, json);
+    else if (!RunScenes(options, json))
+        return -1;
+
+    if (options.Output.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream stream(options.Output);
+        stream << json.str();
+    }
+    return s_Failed ? 2 : 0;
+}
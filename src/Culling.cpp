@@ -0,0 +1,256 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Profiler.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define CULLING_SSE 1
+#else
+    #define CULLING_SSE 0
+#endif
+
+AABB AABB::Transformed(const glm::mat4& matrix) const {
+    const glm::vec3 center = glm::vec3(matrix * glm::vec4((Min + Max) * 0.5f, 1.0f));
+    const glm::vec3 extent = (Max - Min) * 0.5f;
+    const glm::vec3 newExtent = glm::abs(glm::vec3(matrix[0])) * extent.x
+                              + glm::abs(glm::vec3(matrix[1])) * extent.y
+                              + glm::abs(glm::vec3(matrix[2])) * extent.z;
+    return { center - newExtent, center + newExtent };
+}
+
+Frustum::Frustum(const glm::mat4& viewProjection) {
+    // Gribb/Hartmann: each clip plane is the last row plus or minus another row
+    const glm::mat4 m = glm::transpose(viewProjection);
+    const glm::vec4 planes[6] = {
+        m[3] + m[0], m[3] - m[0],  // left, right
+        m[3] + m[1], m[3] - m[1],  // bottom, top
+        m[3] + m[2], m[3] - m[2],  // near, far
+    };
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 plane(0.0f, 0.0f, 0.0f, 1.0f);
+        if (i < 6) {
+            const float length = glm::length(glm::vec3(planes[i]));
+            if (length > 0.0f)
+                plane = planes[i] / length;
+        }
+        m_NormalX[i] = plane.x;
+        m_NormalY[i] = plane.y;
+        m_NormalZ[i] = plane.z;
+        m_Distance[i] = plane.w;
+    }
+
+    const glm::mat4 inverse = glm::inverse(viewProjection);
+    m_Bounds = { glm::vec3(INFINITY), glm::vec3(-INFINITY) };
+    for (int corner = 0; corner < 8; corner++) {
+        const glm::vec4 ndc(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f, 1.0f);
+        const glm::vec4 world = inverse * ndc;
+        const glm::vec3 point = glm::vec3(world) / world.w;
+        m_Bounds.Min = glm::min(m_Bounds.Min, point);
+        m_Bounds.Max = glm::max(m_Bounds.Max, point);
+    }
+}
+
+// A box is outside when its center is further behind some plane than its
+// projected radius, and inside when it is in front of every plane by that much.
+Frustum::Containment Frustum::Classify(const AABB& box) const {
+    const glm::vec3 center = (box.Min + box.Max) * 0.5f;
+    const glm::vec3 extent = (box.Max - box.Min) * 0.5f;
+#if CULLING_SSE
+    const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+    const __m128 ex = _mm_set1_ps(extent.x), ey = _mm_set1_ps(extent.y), ez = _mm_set1_ps(extent.z);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    int outside = 0;
+    int straddling = 0;
+    for (int i = 0; i < 8; i += 4) {
+        const __m128 nx = _mm_load_ps(m_NormalX + i);
+        const __m128 ny = _mm_load_ps(m_NormalY + i);
+        const __m128 nz = _mm_load_ps(m_NormalZ + i);
+        __m128 distance = _mm_add_ps(_mm_load_ps(m_Distance + i), _mm_mul_ps(nx, cx));
+        distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(ny, cy), _mm_mul_ps(nz, cz)));
+        __m128 radius = _mm_mul_ps(_mm_andnot_ps(signMask, nx), ex);
+        radius = _mm_add_ps(radius, _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, ny), ey),
+                                               _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez)));
+        outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        straddling |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), _mm_setzero_ps()));
+    }
+#else
+    bool outside = false;
+    bool straddling = false;
+    for (int i = 0; i < 6; i++) {
+        const float distance = m_NormalX[i] * center.x + m_NormalY[i] * center.y + m_NormalZ[i] * center.z + m_Distance[i];
+        const float radius = std::abs(m_NormalX[i]) * extent.x + std::abs(m_NormalY[i]) * extent.y + std::abs(m_NormalZ[i]) * extent.z;
+        outside |= distance + radius < 0.0f;
+        straddling |= distance - radius < 0.0f;
+    }
+#endif
+    if (outside)
+        return Containment::Outside;
+    return straddling ? Containment::Intersecting : Containment::Inside;
+}
+
+// Cell coordinates are clamped to 21 bits each so they pack into one key
+static constexpr int CellCoordLimit = (1 << 20) - 1;
+
+static inline uint64_t CellKey(const glm::ivec3& coord) {
+    const auto pack = [](int value) { return static_cast<uint64_t>(value + (1 << 20)) & 0x1FFFFF; };
+    return pack(coord.x) << 42 | pack(coord.y) << 21 | pack(coord.z);
+}
+
+SpatialGrid::SpatialGrid(float cellSize) : m_CellSize(cellSize) {
+}
+
+SpatialGrid::CellRange SpatialGrid::GetCellRange(const AABB& bounds) const {
+    const auto toCell = [this](const glm::vec3& point) {
+        const glm::vec3 cell = glm::clamp(glm::floor(point / m_CellSize),
+                                          glm::vec3(-CellCoordLimit), glm::vec3(CellCoordLimit));
+        return glm::ivec3(cell);
+    };
+    return { toCell(bounds.Min), toCell(bounds.Max) };
+}
+
+static inline bool Contains(const glm::ivec3& min, const glm::ivec3& max, const glm::ivec3& coord) {
+    return glm::all(glm::greaterThanEqual(coord, min)) && glm::all(glm::lessThanEqual(coord, max));
+}
+
+void SpatialGrid::AddToCells(ObjectID id, const CellRange& range) {
+    for (int z = range.Min.z; z <= range.Max.z; z++)
+        for (int y = range.Min.y; y <= range.Max.y; y++)
+            for (int x = range.Min.x; x <= range.Max.x; x++) {
+                const glm::ivec3 coord(x, y, z);
+                Cell& cell = m_Cells[CellKey(coord)];
+                cell.Coord = coord;
+                cell.Objects.push_back(id);
+            }
+}
+
+void SpatialGrid::RemoveFromCells(ObjectID id, const CellRange& range) {
+    for (int z = range.Min.z; z <= range.Max.z; z++)
+        for (int y = range.Min.y; y <= range.Max.y; y++)
+            for (int x = range.Min.x; x <= range.Max.x; x++) {
+                auto it = m_Cells.find(CellKey({ x, y, z }));
+                if (it == m_Cells.end())
+                    continue;
+                std::vector<ObjectID>& objects = it->second.Objects;
+                auto found = std::find(objects.begin(), objects.end(), id);
+                if (found != objects.end()) {
+                    *found = objects.back();
+                    objects.pop_back();
+                }
+                if (objects.empty())
+                    m_Cells.erase(it);
+            }
+}
+
+SpatialGrid::ObjectID SpatialGrid::Insert(const AABB& bounds) {
+    ObjectID id;
+    if (!m_FreeIDs.empty()) {
+        id = m_FreeIDs.back();
+        m_FreeIDs.pop_back();
+    } else {
+        id = static_cast<ObjectID>(m_Bounds.size());
+        m_Bounds.emplace_back();
+        m_Ranges.emplace_back();
+        m_QueryStamps.push_back(0);
+        m_Alive.push_back(0);
+    }
+
+    m_Bounds[id] = bounds;
+    m_Ranges[id] = GetCellRange(bounds);
+    m_QueryStamps[id] = 0;
+    m_Alive[id] = 1;
+    m_ObjectCount++;
+    AddToCells(id, m_Ranges[id]);
+    return id;
+}
+
+void SpatialGrid::Update(ObjectID id, const AABB& bounds) {
+    m_Bounds[id] = bounds;
+    const CellRange newRange = GetCellRange(bounds);
+    const CellRange oldRange = m_Ranges[id];
+    if (newRange.Min == oldRange.Min && newRange.Max == oldRange.Max)
+        return;
+
+    // Only the cells the object left or entered are touched
+    for (int z = oldRange.Min.z; z <= oldRange.Max.z; z++)
+        for (int y = oldRange.Min.y; y <= oldRange.Max.y; y++)
+            for (int x = oldRange.Min.x; x <= oldRange.Max.x; x++) {
+                const glm::ivec3 coord(x, y, z);
+                if (!Contains(newRange.Min, newRange.Max, coord))
+                    RemoveFromCells(id, { coord, coord });
+            }
+    for (int z = newRange.Min.z; z <= newRange.Max.z; z++)
+        for (int y = newRange.Min.y; y <= newRange.Max.y; y++)
+            for (int x = newRange.Min.x; x <= newRange.Max.x; x++) {
+                const glm::ivec3 coord(x, y, z);
+                if (!Contains(oldRange.Min, oldRange.Max, coord))
+                    AddToCells(id, { coord, coord });
+            }
+    m_Ranges[id] = newRange;
+}
+
+void SpatialGrid::Remove(ObjectID id) {
+    if (!m_Alive[id])
+        return;
+    RemoveFromCells(id, m_Ranges[id]);
+    m_Alive[id] = 0;
+    m_FreeIDs.push_back(id);
+    m_ObjectCount--;
+}
+
+void SpatialGrid::QueryCell(const Cell& cell, const Frustum& frustum, std::vector<ObjectID>& visible) {
+    const glm::vec3 cellMin = glm::vec3(cell.Coord) * m_CellSize;
+    const Frustum::Containment containment = frustum.Classify({ cellMin, cellMin + glm::vec3(m_CellSize) });
+    if (containment == Frustum::Containment::Outside)
+        return;
+    m_Stats.CellsVisited++;
+
+    // Objects spanning several cells are only reported once per query
+    for (ObjectID id : cell.Objects) {
+        if (m_QueryStamps[id] == m_QueryStamp)
+            continue;
+        m_QueryStamps[id] = m_QueryStamp;
+        if (containment == Frustum::Containment::Inside || frustum.Intersects(m_Bounds[id]))
+            visible.push_back(id);
+    }
+}
+
+void SpatialGrid::Query(const Frustum& frustum, std::vector<ObjectID>& visible) {
+    PROFILE_SCOPE("SpatialGrid::Query");
+
+    m_Stats = {};
+    if (++m_QueryStamp == 0) {
+        std::fill(m_QueryStamps.begin(), m_QueryStamps.end(), 0);
+        m_QueryStamp = 1;
+    }
+
+    const size_t firstVisible = visible.size();
+    const CellRange range = GetCellRange(frustum.GetBounds());
+    const glm::ivec3 size = range.Max - range.Min + 1;
+    const uint64_t cellCount = static_cast<uint64_t>(size.x) * static_cast<uint64_t>(size.y) * static_cast<uint64_t>(size.z);
+    if (cellCount <= m_Cells.size()) {
+        // Small view over a busy grid: look up only the cells under the frustum
+        for (int z = range.Min.z; z <= range.Max.z; z++)
+            for (int y = range.Min.y; y <= range.Max.y; y++)
+                for (int x = range.Min.x; x <= range.Max.x; x++) {
+                    auto it = m_Cells.find(CellKey({ x, y, z }));
+                    if (it != m_Cells.end())
+                        QueryCell(it->second, frustum, visible);
+                }
+    } else {
+        // Large view over a sparse grid: walk the occupied cells instead
+        for (const auto& [key, cell] : m_Cells) {
+            if (Contains(range.Min, range.Max, cell.Coord))
+                QueryCell(cell, frustum, visible);
+        }
+    }
+
+    m_Stats.Visible = static_cast<unsigned int>(visible.size() - firstVisible);
+    m_Stats.Culled = m_ObjectCount - m_Stats.Visible;
+}
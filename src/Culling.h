@@ -0,0 +1,94 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct AABB {
+    glm::vec3 Min;
+    glm::vec3 Max;
+
+    // Bounds of this box after transforming it by matrix
+    AABB Transformed(const glm::mat4& matrix) const;
+};
+
+// The six planes of a view-projection matrix, orthographic or perspective.
+// Stored as structure-of-arrays so a box is tested against four planes at once.
+class Frustum {
+public:
+    enum class Containment { Outside, Intersecting, Inside };
+private:
+    // Planes 6 and 7 are padding that never rejects anything
+    alignas(16) float m_NormalX[8];
+    alignas(16) float m_NormalY[8];
+    alignas(16) float m_NormalZ[8];
+    alignas(16) float m_Distance[8];
+    AABB m_Bounds;
+public:
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    Containment Classify(const AABB& box) const;
+    inline bool Intersects(const AABB& box) const { return Classify(box) != Containment::Outside; }
+    // Plane i as (normal, distance), normalized; points inside have dot(normal, p) + distance >= 0
+    inline glm::vec4 GetPlane(int i) const { return { m_NormalX[i], m_NormalY[i], m_NormalZ[i], m_Distance[i] }; }
+    // World-space box around the frustum corners
+    inline const AABB& GetBounds() const { return m_Bounds; }
+};
+
+// Uniform grid over world space that objects are filed into by their bounds.
+// Moving an object only touches the grid when it crosses into other cells.
+class SpatialGrid {
+public:
+    using ObjectID = uint32_t;
+
+    struct Stats {
+        unsigned int Visible = 0;
+        unsigned int Culled = 0;
+        unsigned int CellsVisited = 0;
+    };
+private:
+    struct CellRange {
+        glm::ivec3 Min;
+        glm::ivec3 Max;
+    };
+
+    struct Cell {
+        glm::ivec3 Coord;
+        std::vector<ObjectID> Objects;
+    };
+
+    float m_CellSize;
+    std::unordered_map<uint64_t, Cell> m_Cells;
+    std::vector<AABB> m_Bounds;
+    std::vector<CellRange> m_Ranges;
+    std::vector<uint32_t> m_QueryStamps;
+    std::vector<uint8_t> m_Alive;
+    std::vector<ObjectID> m_FreeIDs;
+    uint32_t m_QueryStamp = 0;
+    unsigned int m_ObjectCount = 0;
+    Stats m_Stats;
+public:
+    explicit SpatialGrid(float cellSize = 128.0f);
+
+    ObjectID Insert(const AABB& bounds);
+    void Update(ObjectID id, const AABB& bounds);
+    void Remove(ObjectID id);
+
+    // Appends the objects whose bounds intersect the frustum to visible
+    void Query(const Frustum& frustum, std::vector<ObjectID>& visible);
+
+    inline const AABB& GetBounds(ObjectID id) const { return m_Bounds[id]; }
+    inline unsigned int GetObjectCount() const { return m_ObjectCount; }
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    CellRange GetCellRange(const AABB& bounds) const;
+    void AddToCells(ObjectID id, const CellRange& range);
+    void RemoveFromCells(ObjectID id, const CellRange& range);
+    void QueryCell(const Cell& cell, const Frustum& frustum, std::vector<ObjectID>& visible);
+};
@@ -0,0 +1,122 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "DynamicVertexBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+DynamicVertexBuffer::DynamicVertexBuffer(unsigned int regionSize, unsigned int regionCount)
+    : m_Mode(GLEW_ARB_buffer_storage ? Mode::PersistentMapped : Mode::Orphaning),
+      m_RegionSize(regionSize), m_RegionCount(regionCount) {
+
+    GLCall(glGenBuffers(1, &m_RendererID));
+    Bind();
+
+    if (m_Mode == Mode::PersistentMapped) {
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_RegionSize) * m_RegionCount;
+        GLCall(glBufferStorage(GL_ARRAY_BUFFER, totalSize, nullptr, flags));
+        GLCall(m_MappedData = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags)));
+        m_Fences.resize(m_RegionCount, nullptr);
+    } else {
+        // Orphaning only ever needs one region of storage; the driver hands out
+        // a fresh block each time the old one is still in flight
+        m_RegionCount = 1;
+        m_Staging.resize(m_RegionSize);
+        GLCall(glBufferData(GL_ARRAY_BUFFER, m_RegionSize, nullptr, GL_STREAM_DRAW));
+    }
+}
+
+DynamicVertexBuffer::~DynamicVertexBuffer() {
+    for (GLsync fence : m_Fences) {
+        if (fence) {
+            GLCall(glDeleteSync(fence));
+        }
+    }
+
+    if (m_MappedData) {
+        Bind();
+        GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+    }
+    GLStateCache::OnDeleteBuffer(m_RendererID);
+    GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+void* DynamicVertexBuffer::Allocate(unsigned int size, unsigned int alignment, unsigned int &offset) {
+    ASSERT(size <= m_RegionSize);
+
+    unsigned int start = (m_Cursor + alignment - 1) / alignment * alignment;
+    if (start + size > m_RegionSize) {
+        // The region is exhausted mid-frame; move on rather than overwrite
+        // data that draws already issued this frame still reference
+        NextRegion();
+        start = 0;
+    }
+    m_Cursor = start + size;
+
+    if (m_Mode == Mode::PersistentMapped) {
+        offset = m_Region * m_RegionSize + start;
+        return m_MappedData + offset;
+    }
+
+    offset = start;
+    return m_Staging.data() + start;
+}
+
+void DynamicVertexBuffer::Commit() {
+    if (m_Mode == Mode::Orphaning && m_Cursor > m_Committed) {
+        Bind();
+        GLCall(glBufferSubData(GL_ARRAY_BUFFER, m_Committed, m_Cursor - m_Committed, m_Staging.data() + m_Committed));
+    }
+    // Persistent storage is coherent, so writes are visible without a flush
+    m_Committed = m_Cursor;
+}
+
+void DynamicVertexBuffer::EndFrame() {
+    if (m_Cursor > 0)
+        NextRegion();
+}
+
+void DynamicVertexBuffer::NextRegion() {
+    Commit();
+
+    if (m_Mode == Mode::PersistentMapped) {
+        GLCall(m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_Region = (m_Region + 1) % m_RegionCount;
+        WaitForRegion(m_Region);
+    } else {
+        Bind();
+        GLCall(glBufferData(GL_ARRAY_BUFFER, m_RegionSize, nullptr, GL_STREAM_DRAW));
+    }
+
+    m_Cursor = 0;
+    m_Committed = 0;
+}
+
+void DynamicVertexBuffer::WaitForRegion(unsigned int region) {
+    GLsync& fence = m_Fences[region];
+    if (!fence)
+        return;
+
+    GLenum result;
+    GLCall(result = glClientWaitSync(fence, 0, 0));
+    if (result == GL_TIMEOUT_EXPIRED) {
+        m_StallCount++;
+        do {
+            GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+
+    GLCall(glDeleteSync(fence));
+    fence = nullptr;
+}
+
+void DynamicVertexBuffer::Bind() const {
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+}
+
+void DynamicVertexBuffer::Unbind() const {
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
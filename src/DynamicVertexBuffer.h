@@ -0,0 +1,64 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <vector>
+#include <GL/glew.h>
+
+// Ring buffer for vertex data that changes every frame. The storage is split
+// into frame regions, each guarded by a fence, so the CPU never writes into a
+// range the GPU may still be reading from.
+//
+// With GL 4.4 / ARB_buffer_storage the buffer is mapped once (persistent and
+// coherent) and Allocate returns pointers straight into GPU-visible memory.
+// Otherwise writes go to a CPU staging area that is uploaded on Commit with
+// glBufferSubData into freshly orphaned storage.
+class DynamicVertexBuffer {
+public:
+    enum class Mode {
+        PersistentMapped, Orphaning
+    };
+
+private:
+    unsigned int m_RendererID{};
+    Mode m_Mode;
+    unsigned int m_RegionSize;
+    unsigned int m_RegionCount;
+    unsigned int m_Region{};
+    unsigned int m_Cursor{};
+    unsigned int m_Committed{};
+    unsigned char* m_MappedData{};
+    std::vector<unsigned char> m_Staging;
+    std::vector<GLsync> m_Fences;
+    unsigned int m_StallCount{};
+
+public:
+    explicit DynamicVertexBuffer(unsigned int regionSize, unsigned int regionCount = 3);
+    ~DynamicVertexBuffer();
+
+    DynamicVertexBuffer(const DynamicVertexBuffer&) = delete;
+    DynamicVertexBuffer& operator=(const DynamicVertexBuffer&) = delete;
+
+    // Returns a write pointer for size bytes aligned to alignment. offset receives
+    // the byte offset of that memory inside the GL buffer, for attribute
+    // pointers or base vertex draws.
+    void* Allocate(unsigned int size, unsigned int alignment, unsigned int& offset);
+    // Makes everything allocated since the last Commit visible to GL
+    void Commit();
+    // Fences the region used this frame and moves on to the next one
+    void EndFrame();
+
+    void Bind() const;
+    void Unbind() const;
+
+    inline Mode GetMode() const { return m_Mode; }
+    inline unsigned int GetRegionSize() const { return m_RegionSize; }
+    // Number of times the CPU had to wait for the GPU to release a region
+    inline unsigned int GetStallCount() const { return m_StallCount; }
+
+private:
+    void NextRegion();
+    void WaitForRegion(unsigned int region);
+};
@@ -0,0 +1,132 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "Font.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Profiler.h"
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imgui/stb_truetype.h"
+
+// Distance field value on the outline; pixels inside are brighter
+static constexpr unsigned char s_OnEdgeValue = 128;
+static constexpr float s_PixelDistanceScale = static_cast<float>(s_OnEdgeValue) / Font::Padding;
+
+Font::Font(const std::string &path, float pixelHeight, int atlasSize)
+    : m_File(std::make_unique<MappedFile>(path)), m_PixelHeight(pixelHeight), m_AtlasSize(atlasSize) {
+    const unsigned char* data = m_File->GetData();
+    m_Info = std::make_unique<stbtt_fontinfo>();
+    if (!m_File->IsValid() || !stbtt_InitFont(m_Info.get(), data, stbtt_GetFontOffsetForIndex(data, 0))) {
+        std::cout << "Failed to load font '" << path << "'" << std::endl;
+        return;
+    }
+
+    m_Scale = stbtt_ScaleForPixelHeight(m_Info.get(), pixelHeight);
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(m_Info.get(), &ascent, &descent, &lineGap);
+    m_Ascent = ascent * m_Scale;
+    m_Descent = descent * m_Scale;
+    m_LineGap = lineGap * m_Scale;
+
+    // White everywhere, so the atlas also samples sensibly as a plain texture
+    m_Pixels.resize(static_cast<size_t>(atlasSize) * atlasSize * 4, 0xff);
+    for (size_t i = 3; i < m_Pixels.size(); i += 4)
+        m_Pixels[i] = 0;
+    m_Texture = std::make_unique<Texture>(atlasSize, atlasSize, m_Pixels.data());
+}
+
+Font::~Font() = default;
+
+const Glyph& Font::GetGlyph(uint32_t codepoint) {
+    const auto it = m_Glyphs.find(codepoint);
+    if (it != m_Glyphs.end())
+        return it->second;
+
+    m_Stats.Glyphs++;
+    return m_Glyphs.emplace(codepoint, Rasterize(codepoint)).first->second;
+}
+
+float Font::GetKerning(const Glyph &left, const Glyph &right) const {
+    return stbtt_GetGlyphKernAdvance(m_Info.get(), left.Index, right.Index) * m_Scale;
+}
+
+const Texture& Font::GetTexture() {
+    if (m_DirtyBegin < m_DirtyEnd) {
+        PROFILE_GPU_SCOPE("Font::Upload");
+        m_Texture->SetSubData(0, m_DirtyBegin, m_AtlasSize, m_DirtyEnd - m_DirtyBegin,
+                              &m_Pixels[static_cast<size_t>(m_DirtyBegin) * m_AtlasSize * 4]);
+        m_DirtyBegin = m_DirtyEnd = 0;
+        m_Stats.Uploads++;
+    }
+    return *m_Texture;
+}
+
+Glyph Font::Rasterize(uint32_t codepoint) {
+    Glyph glyph{};
+    if (!IsValid())
+        return glyph;
+
+    PROFILE_SCOPE("Font::Rasterize");
+    glyph.Index = stbtt_FindGlyphIndex(m_Info.get(), static_cast<int>(codepoint));
+    int advance, leftBearing;
+    stbtt_GetGlyphHMetrics(m_Info.get(), glyph.Index, &advance, &leftBearing);
+    glyph.Advance = advance * m_Scale;
+
+    int width, height, xOffset, yOffset;
+    unsigned char* field = stbtt_GetGlyphSDF(m_Info.get(), m_Scale, glyph.Index, Padding, s_OnEdgeValue, s_PixelDistanceScale,
+                                             &width, &height, &xOffset, &yOffset);
+    if (!field)
+        return glyph;
+
+    int x, y;
+    if (!Allocate(width, height, x, y)) {
+        std::cout << "Warning: font atlas is full, glyph " << codepoint << " is not drawn" << std::endl;
+        stbtt_FreeSDF(field, nullptr);
+        return glyph;
+    }
+
+    // stb_truetype writes rows top down; the atlas is bottom row first
+    for (int row = 0; row < height; row++) {
+        unsigned char* destination = &m_Pixels[(static_cast<size_t>(y + height - 1 - row) * m_AtlasSize + x) * 4];
+        for (int column = 0; column < width; column++)
+            destination[column * 4 + 3] = field[row * width + column];
+    }
+    stbtt_FreeSDF(field, nullptr);
+
+    if (m_DirtyBegin == m_DirtyEnd) {
+        m_DirtyBegin = y;
+        m_DirtyEnd = y + height;
+    } else {
+        m_DirtyBegin = std::min(m_DirtyBegin, y);
+        m_DirtyEnd = std::max(m_DirtyEnd, y + height);
+    }
+
+    const float atlasSize = static_cast<float>(m_AtlasSize);
+    glyph.Offset = { static_cast<float>(xOffset), static_cast<float>(-(yOffset + height)) };
+    glyph.Size = { static_cast<float>(width), static_cast<float>(height) };
+    glyph.UVMin = glm::vec2(static_cast<float>(x), static_cast<float>(y)) / atlasSize;
+    glyph.UVMax = glm::vec2(static_cast<float>(x + width), static_cast<float>(y + height)) / atlasSize;
+    return glyph;
+}
+
+// Shelf packing: glyphs of one size have similar heights, so rows waste little
+bool Font::Allocate(int width, int height, int &x, int &y) {
+    if (m_ShelfX + width > m_AtlasSize) {
+        m_ShelfY += m_ShelfHeight + 1;
+        m_ShelfX = 0;
+        m_ShelfHeight = 0;
+    }
+    if (width > m_AtlasSize || m_ShelfY + height > m_AtlasSize)
+        return false;
+
+    x = m_ShelfX;
+    y = m_ShelfY;
+    m_ShelfX += width + 1;
+    m_ShelfHeight = std::max(m_ShelfHeight, height);
+    return true;
+}
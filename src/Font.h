@@ -0,0 +1,90 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "MappedFile.h"
+#include "Texture.h"
+
+struct stbtt_fontinfo;
+
+// Placement of one glyph at the font's base pixel height, y up
+struct Glyph {
+    int Index;           // Glyph index in the font, for kerning
+    glm::vec2 Offset;    // Bottom-left corner of the quad relative to the pen
+    glm::vec2 Size;      // Zero for glyphs with nothing to draw, like spaces
+    glm::vec2 UVMin;
+    glm::vec2 UVMax;
+    float Advance;
+};
+
+// TrueType font rendered through a signed distance field atlas. Glyphs are
+// rasterized the first time they are asked for and packed into shelves of
+// one RGBA texture, distance in alpha. A distance field keeps edges sharp at
+// any scale, so one atlas serves every text size.
+class Font {
+public:
+    // Distance field spread around each glyph, in atlas pixels
+    static constexpr int Padding = 4;
+
+    struct Stats {
+        unsigned int Glyphs = 0;
+        unsigned int Uploads = 0;
+    };
+private:
+    std::unique_ptr<MappedFile> m_File;
+    std::unique_ptr<stbtt_fontinfo> m_Info;
+    float m_PixelHeight;
+    float m_Scale = 0.0f;
+    float m_Ascent = 0.0f;
+    float m_Descent = 0.0f;
+    float m_LineGap = 0.0f;
+    std::unordered_map<uint32_t, Glyph> m_Glyphs;
+
+    int m_AtlasSize;
+    std::vector<unsigned char> m_Pixels;
+    std::unique_ptr<Texture> m_Texture;
+    int m_ShelfX = 0;
+    int m_ShelfY = 0;
+    int m_ShelfHeight = 0;
+    // Rows rasterized into m_Pixels but not yet uploaded, [begin, end)
+    int m_DirtyBegin = 0;
+    int m_DirtyEnd = 0;
+    Stats m_Stats;
+public:
+    // pixelHeight is the size glyphs are rasterized at; text drawn much
+    // larger than about four times that starts to round its corners
+    explicit Font(const std::string& path, float pixelHeight = 48.0f, int atlasSize = 1024);
+    ~Font();
+
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
+    inline bool IsValid() const { return m_Texture != nullptr; }
+
+    // Codepoints the font lacks map to its missing glyph
+    const Glyph& GetGlyph(uint32_t codepoint);
+    float GetKerning(const Glyph& left, const Glyph& right) const;
+
+    inline float GetPixelHeight() const { return m_PixelHeight; }
+    inline float GetAscent() const { return m_Ascent; }
+    inline float GetDescent() const { return m_Descent; }
+    inline float GetLineHeight() const { return m_Ascent - m_Descent + m_LineGap; }
+
+    // Uploads glyphs rasterized since the last call first. Context thread and
+    // valid fonts only.
+    const Texture& GetTexture();
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    Glyph Rasterize(uint32_t codepoint);
+    bool Allocate(int width, int height, int& x, int& y);
+};
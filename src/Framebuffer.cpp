@@ -0,0 +1,159 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "Framebuffer.h"
+
+#include <iostream>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "RenderTarget.h"
+
+static void CheckStatus() {
+    GLCall(const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "Framebuffer is incomplete (" << status << ")" << std::endl;
+}
+
+Framebuffer::Framebuffer(const FramebufferSpecification& specification) : m_Specification(specification) {
+    Create();
+}
+
+Framebuffer::Framebuffer(const std::vector<const RenderTarget*> &colorTargets, const RenderTarget *depthTarget)
+    : m_OwnsAttachments(false), m_ColorCount(static_cast<unsigned int>(colorTargets.size())) {
+    const RenderTarget* first = colorTargets.empty() ? depthTarget : colorTargets[0];
+    if (first)
+        m_Specification = { first->GetWidth(), first->GetHeight(), depthTarget != nullptr };
+
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+
+    std::vector<GLenum> drawBuffers;
+    for (unsigned int i = 0; i < m_ColorCount; i++) {
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, colorTargets[i]->GetRendererID(), 0));
+        drawBuffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+    }
+    if (m_ColorCount > 0)
+        m_ColorAttachment = colorTargets[0]->GetRendererID();
+
+    // A depth-only framebuffer, like a shadow map, draws and reads no color
+    if (drawBuffers.empty()) {
+        GLCall(glDrawBuffer(GL_NONE));
+        GLCall(glReadBuffer(GL_NONE));
+    } else {
+        GLCall(glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data()));
+    }
+
+    if (depthTarget) {
+        m_DepthAttachmentPoint = depthTarget->GetDescription().Format == RenderTargetFormat::Depth24Stencil8
+            ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, m_DepthAttachmentPoint, GL_TEXTURE_2D, depthTarget->GetRendererID(), 0));
+    }
+
+    CheckStatus();
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+Framebuffer::~Framebuffer() {
+    Destroy();
+}
+
+void Framebuffer::Create() {
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+
+    GLCall(glGenTextures(1, &m_ColorAttachment));
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_ColorAttachment);
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Specification.Width, m_Specification.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
+    GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorAttachment, 0));
+
+    if (m_Specification.DepthStencil) {
+        GLCall(glGenRenderbuffers(1, &m_DepthStencilAttachment));
+        GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_DepthStencilAttachment));
+        GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Specification.Width, m_Specification.Height));
+        GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencilAttachment));
+        m_DepthAttachmentPoint = GL_DEPTH_STENCIL_ATTACHMENT;
+    }
+
+    CheckStatus();
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void Framebuffer::Destroy() {
+    if (m_OwnsAttachments) {
+        GLStateCache::OnDeleteTexture(m_ColorAttachment);
+        GLCall(glDeleteTextures(1, &m_ColorAttachment));
+        if (m_DepthStencilAttachment) {
+            GLCall(glDeleteRenderbuffers(1, &m_DepthStencilAttachment));
+        }
+    }
+    GLCall(glDeleteFramebuffers(1, &m_RendererID));
+    m_RendererID = m_ColorAttachment = m_DepthStencilAttachment = m_DepthAttachmentPoint = 0;
+}
+
+void Framebuffer::Bind() const {
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glViewport(0, 0, m_Specification.Width, m_Specification.Height));
+}
+
+void Framebuffer::Unbind() const {
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void Framebuffer::Resize(int width, int height) {
+    ASSERT(m_OwnsAttachments);
+    if (width == m_Specification.Width && height == m_Specification.Height)
+        return;
+
+    Destroy();
+    m_Specification.Width = width;
+    m_Specification.Height = height;
+    Create();
+}
+
+void Framebuffer::ReadPixels(std::vector<unsigned char>& pixels, unsigned int attachment) const {
+    pixels.resize(static_cast<size_t>(m_Specification.Width) * m_Specification.Height * 4);
+
+    // RGBA8 rows are always 4-byte aligned, so the default pack alignment fits
+    GLint previousFramebuffer = 0, previousReadBuffer = 0;
+    GLCall(glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer));
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID));
+    // The read buffer belongs to the framebuffer object, so put ours back as it was
+    GLCall(glGetIntegerv(GL_READ_BUFFER, &previousReadBuffer));
+
+    GLCall(glReadBuffer(GL_COLOR_ATTACHMENT0 + attachment));
+    GLStateCache::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    GLCall(glReadPixels(0, 0, m_Specification.Width, m_Specification.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+
+    GLCall(glReadBuffer(previousReadBuffer));
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, previousFramebuffer));
+}
+
+void Framebuffer::Invalidate(unsigned int colorMask, bool depth) const {
+    if (!SupportsInvalidate())
+        return;
+
+    GLenum attachments[9];
+    GLsizei count = 0;
+    for (unsigned int i = 0; i < m_ColorCount && i < 8; i++) {
+        if (colorMask & (1u << i))
+            attachments[count++] = GL_COLOR_ATTACHMENT0 + i;
+    }
+    if (depth && m_DepthAttachmentPoint)
+        attachments[count++] = m_DepthAttachmentPoint;
+    if (count == 0)
+        return;
+
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments));
+}
+
+bool Framebuffer::SupportsInvalidate() {
+    return GLEW_VERSION_4_3 || GLEW_ARB_invalidate_subdata;
+}
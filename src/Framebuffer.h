@@ -0,0 +1,62 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <vector>
+
+struct FramebufferSpecification {
+    int Width = 0;
+    int Height = 0;
+    bool DepthStencil = true;
+};
+
+class RenderTarget;
+
+// Either an RGBA8 color texture with an optional depth/stencil renderbuffer,
+// both owned, or render targets owned elsewhere attached as they are
+class Framebuffer {
+private:
+    unsigned int m_RendererID{};
+    unsigned int m_ColorAttachment{};
+    unsigned int m_DepthStencilAttachment{};
+    FramebufferSpecification m_Specification;
+    bool m_OwnsAttachments = true;
+    unsigned int m_ColorCount = 1;
+    unsigned int m_DepthAttachmentPoint = 0; // GL_DEPTH(_STENCIL)_ATTACHMENT, 0 without depth
+public:
+    explicit Framebuffer(const FramebufferSpecification& specification);
+    // Color targets become attachments 0 to N-1 in order; all targets must be the same size
+    explicit Framebuffer(const std::vector<const RenderTarget*>& colorTargets, const RenderTarget* depthTarget = nullptr);
+    ~Framebuffer();
+
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    // Also sets the viewport to the framebuffer size
+    void Bind() const;
+    void Unbind() const;
+
+    // Only for framebuffers that own their attachments
+    void Resize(int width, int height);
+    // Tightly packed RGBA8 rows of a color attachment, bottom row first
+    void ReadPixels(std::vector<unsigned char>& pixels, unsigned int attachment = 0) const;
+
+    // Tells the driver the contents of these attachments are no longer needed,
+    // so it can skip loading or storing them. Bit i of colorMask is color
+    // attachment i. Leaves this framebuffer bound; does nothing without
+    // GL 4.3 or ARB_invalidate_subdata.
+    void Invalidate(unsigned int colorMask, bool depth) const;
+    static bool SupportsInvalidate();
+
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+    inline unsigned int GetColorAttachment() const { return m_ColorAttachment; }
+    inline unsigned int GetColorCount() const { return m_ColorCount; }
+    inline int GetWidth() const { return m_Specification.Width; }
+    inline int GetHeight() const { return m_Specification.Height; }
+
+private:
+    void Create();
+    void Destroy();
+};
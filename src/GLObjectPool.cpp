@@ -0,0 +1,174 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "GLObjectPool.h"
+
+#include <deque>
+#include <vector>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+static constexpr unsigned int s_BatchSize = 32;
+// Recycled buffer names kept around; anything beyond is deleted
+static constexpr unsigned int s_MaxFreeBuffers = 256;
+
+struct ReleasedObjects {
+    std::vector<unsigned int> Buffers;
+    std::vector<unsigned int> Textures;
+    std::vector<unsigned int> VertexArrays;
+    std::vector<unsigned int> Programs;
+
+    unsigned int GetCount() const {
+        return static_cast<unsigned int>(Buffers.size() + Textures.size() + VertexArrays.size() + Programs.size());
+    }
+};
+
+struct RetiredFrame {
+    GLsync Fence;
+    ReleasedObjects Objects;
+};
+
+static std::vector<unsigned int> s_FreeBuffers;
+static std::vector<unsigned int> s_FreeTextures;
+static std::vector<unsigned int> s_FreeVertexArrays;
+static ReleasedObjects s_Released;
+static std::deque<RetiredFrame> s_Retired;
+static GLObjectPool::Stats s_Stats;
+
+template<typename Generate>
+static unsigned int Take(std::vector<unsigned int>& names, Generate generate) {
+    if (names.empty()) {
+        names.resize(s_BatchSize);
+        generate(names.data());
+        s_Stats.GenCalls++;
+    }
+    const unsigned int name = names.back();
+    names.pop_back();
+    return name;
+}
+
+unsigned int GLObjectPool::CreateBuffer() {
+    return Take(s_FreeBuffers, [](unsigned int* names) { GLCall(glGenBuffers(s_BatchSize, names)); });
+}
+
+unsigned int GLObjectPool::CreateTexture() {
+    return Take(s_FreeTextures, [](unsigned int* names) { GLCall(glGenTextures(s_BatchSize, names)); });
+}
+
+unsigned int GLObjectPool::CreateVertexArray() {
+    return Take(s_FreeVertexArrays, [](unsigned int* names) { GLCall(glGenVertexArrays(s_BatchSize, names)); });
+}
+
+void GLObjectPool::DestroyBuffer(unsigned int buffer) {
+    if (buffer)
+        s_Released.Buffers.push_back(buffer);
+}
+
+void GLObjectPool::DestroyTexture(unsigned int texture) {
+    if (texture)
+        s_Released.Textures.push_back(texture);
+}
+
+void GLObjectPool::DestroyVertexArray(unsigned int vertexArray) {
+    if (vertexArray)
+        s_Released.VertexArrays.push_back(vertexArray);
+}
+
+void GLObjectPool::DestroyProgram(unsigned int program) {
+    if (program)
+        s_Released.Programs.push_back(program);
+}
+
+static void Free(ReleasedObjects& objects, bool recycleBuffers) {
+    std::vector<unsigned int> deletedBuffers;
+    for (const unsigned int buffer : objects.Buffers) {
+        if (recycleBuffers && s_FreeBuffers.size() < s_MaxFreeBuffers) {
+            // Drop the storage but keep the name; the next owner redefines it
+            GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            GLCall(glBufferData(GL_COPY_WRITE_BUFFER, 0, nullptr, GL_STATIC_DRAW));
+            s_FreeBuffers.push_back(buffer);
+            s_Stats.Recycled++;
+        } else {
+            GLStateCache::OnDeleteBuffer(buffer);
+            deletedBuffers.push_back(buffer);
+        }
+    }
+    if (!deletedBuffers.empty()) {
+        GLCall(glDeleteBuffers(static_cast<GLsizei>(deletedBuffers.size()), deletedBuffers.data()));
+        s_Stats.DeleteCalls++;
+    }
+
+    if (!objects.Textures.empty()) {
+        for (const unsigned int texture : objects.Textures)
+            GLStateCache::OnDeleteTexture(texture);
+        GLCall(glDeleteTextures(static_cast<GLsizei>(objects.Textures.size()), objects.Textures.data()));
+        s_Stats.DeleteCalls++;
+    }
+
+    if (!objects.VertexArrays.empty()) {
+        for (const unsigned int vertexArray : objects.VertexArrays)
+            GLStateCache::OnDeleteVertexArray(vertexArray);
+        GLCall(glDeleteVertexArrays(static_cast<GLsizei>(objects.VertexArrays.size()), objects.VertexArrays.data()));
+        s_Stats.DeleteCalls++;
+    }
+
+    for (const unsigned int program : objects.Programs) {
+        GLStateCache::OnDeleteProgram(program);
+        GLCall(glDeleteProgram(program));
+        s_Stats.DeleteCalls++;
+    }
+
+    objects = {};
+}
+
+void GLObjectPool::Collect() {
+    if (s_Released.GetCount() > 0) {
+        GLsync fence;
+        GLCall(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        s_Retired.push_back({ fence, std::move(s_Released) });
+        s_Released = {};
+    }
+
+    s_Stats.Pending = 0;
+    while (!s_Retired.empty()) {
+        RetiredFrame& frame = s_Retired.front();
+        GLenum status;
+        GLCall(status = glClientWaitSync(frame.Fence, 0, 0));
+        if (status == GL_TIMEOUT_EXPIRED)
+            break;
+
+        GLCall(glDeleteSync(frame.Fence));
+        Free(frame.Objects, true);
+        s_Retired.pop_front();
+    }
+    for (const RetiredFrame& frame : s_Retired)
+        s_Stats.Pending += frame.Objects.GetCount();
+}
+
+void GLObjectPool::Shutdown() {
+    for (RetiredFrame& frame : s_Retired) {
+        GLCall(glDeleteSync(frame.Fence));
+        Free(frame.Objects, false);
+    }
+    s_Retired.clear();
+    Free(s_Released, false);
+
+    ReleasedObjects unused;
+    unused.Buffers.swap(s_FreeBuffers);
+    unused.Textures.swap(s_FreeTextures);
+    unused.VertexArrays.swap(s_FreeVertexArrays);
+    Free(unused, false);
+    s_Stats.Pending = 0;
+}
+
+const GLObjectPool::Stats& GLObjectPool::GetStats() {
+    return s_Stats;
+}
+
+void GLObjectPool::ResetStats() {
+    const unsigned int pending = s_Stats.Pending;
+    s_Stats = {};
+    s_Stats.Pending = pending;
+}
@@ -0,0 +1,41 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+// Hands out GL names from batches generated ahead of time and takes them back
+// without deleting right away. Names released during a frame are fenced when
+// the frame ends and only freed once the GPU has passed that fence, so
+// deleting an object never makes the driver wait on draws still using it.
+// Buffer names are orphaned and reused, so buffers given immutable storage
+// (glBufferStorage) must not come from here; the other kinds are deleted in
+// one call per kind. Context thread only.
+class GLObjectPool {
+public:
+    struct Stats {
+        unsigned int GenCalls = 0;
+        unsigned int DeleteCalls = 0;
+        unsigned int Recycled = 0;
+        unsigned int Pending = 0;
+    };
+
+    static unsigned int CreateBuffer();
+    static unsigned int CreateTexture();
+    static unsigned int CreateVertexArray();
+
+    // 0 is ignored, so moved-from objects can release unconditionally
+    static void DestroyBuffer(unsigned int buffer);
+    static void DestroyTexture(unsigned int texture);
+    static void DestroyVertexArray(unsigned int vertexArray);
+    static void DestroyProgram(unsigned int program);
+
+    // Once per frame: fences what was released since the last call and frees
+    // everything whose fence the GPU has passed
+    static void Collect();
+    // Frees everything right away; called before the context goes away
+    static void Shutdown();
+
+    static const Stats& GetStats();
+    static void ResetStats();
+};
@@ -0,0 +1,202 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "GLStateCache.h"
+
+#include <unordered_map>
+
+#include "Renderer.h"
+
+static constexpr unsigned int s_Unknown = 0xffffffff;
+
+// Buffer targets whose binding is context state; GL_ELEMENT_ARRAY_BUFFER is
+// vertex array state and is tracked per vertex array instead
+static constexpr unsigned int s_BufferTargets[] = {
+    GL_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER,
+    GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, GL_DRAW_INDIRECT_BUFFER, GL_SHADER_STORAGE_BUFFER
+};
+static constexpr unsigned int s_BufferTargetCount = sizeof(s_BufferTargets) / sizeof(s_BufferTargets[0]);
+
+struct GLState {
+    unsigned int Program = s_Unknown;
+    unsigned int VertexArray = s_Unknown;
+    unsigned int ElementBuffer = s_Unknown;
+    unsigned int ActiveUnit = s_Unknown;
+    unsigned int Buffers[s_BufferTargetCount];
+    unsigned int Textures[GLStateCache::MaxTextureUnits];
+    unsigned int UniformBindings[GLStateCache::MaxBufferBindings];
+    unsigned int StorageBindings[GLStateCache::MaxBufferBindings];
+    std::unordered_map<unsigned int, unsigned int> ElementBufferPerVertexArray;
+
+    GLState() {
+        for (unsigned int& buffer : Buffers)
+            buffer = s_Unknown;
+        for (unsigned int& texture : Textures)
+            texture = s_Unknown;
+        for (unsigned int i = 0; i < GLStateCache::MaxBufferBindings; i++) {
+            UniformBindings[i] = s_Unknown;
+            StorageBindings[i] = s_Unknown;
+        }
+    }
+};
+
+static GLState s_State;
+static GLStateCache::Stats s_Stats;
+
+static int GetBufferTargetIndex(unsigned int target) {
+    for (unsigned int i = 0; i < s_BufferTargetCount; i++) {
+        if (s_BufferTargets[i] == target)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+static bool Update(unsigned int& cached, unsigned int value) {
+    if (cached == value) {
+        s_Stats.Skipped++;
+        return false;
+    }
+    cached = value;
+    s_Stats.Issued++;
+    return true;
+}
+
+void GLStateCache::UseProgram(unsigned int program) {
+    if (Update(s_State.Program, program)) {
+        GLCall(glUseProgram(program));
+    }
+}
+
+void GLStateCache::BindVertexArray(unsigned int vertexArray) {
+    if (!Update(s_State.VertexArray, vertexArray))
+        return;
+
+    GLCall(glBindVertexArray(vertexArray));
+
+    const auto it = s_State.ElementBufferPerVertexArray.find(vertexArray);
+    s_State.ElementBuffer = it != s_State.ElementBufferPerVertexArray.end() ? it->second : s_Unknown;
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer) {
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        if (!Update(s_State.ElementBuffer, buffer))
+            return;
+
+        GLCall(glBindBuffer(target, buffer));
+        if (s_State.VertexArray != s_Unknown)
+            s_State.ElementBufferPerVertexArray[s_State.VertexArray] = buffer;
+        return;
+    }
+
+    const int index = GetBufferTargetIndex(target);
+    if (index < 0) {
+        s_Stats.Issued++;
+        GLCall(glBindBuffer(target, buffer));
+        return;
+    }
+
+    if (Update(s_State.Buffers[index], buffer)) {
+        GLCall(glBindBuffer(target, buffer));
+    }
+}
+
+void GLStateCache::BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer) {
+    unsigned int* bindings = nullptr;
+    if (target == GL_UNIFORM_BUFFER)
+        bindings = s_State.UniformBindings;
+    else if (target == GL_SHADER_STORAGE_BUFFER)
+        bindings = s_State.StorageBindings;
+
+    if (bindings && index < MaxBufferBindings && !Update(bindings[index], buffer))
+        return;
+    if (!bindings || index >= MaxBufferBindings)
+        s_Stats.Issued++;
+
+    GLCall(glBindBufferBase(target, index, buffer));
+
+    const int targetIndex = GetBufferTargetIndex(target);
+    if (targetIndex >= 0)
+        s_State.Buffers[targetIndex] = buffer;
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int target, unsigned int texture) {
+    ASSERT(unit < MaxTextureUnits);
+
+    if (target != GL_TEXTURE_2D) {
+        if (Update(s_State.ActiveUnit, unit)) {
+            GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+        }
+        s_Stats.Issued++;
+        GLCall(glBindTexture(target, texture));
+        return;
+    }
+
+    if (s_State.Textures[unit] == texture) {
+        s_Stats.Skipped++;
+        return;
+    }
+
+    if (Update(s_State.ActiveUnit, unit)) {
+        GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+    }
+
+    s_State.Textures[unit] = texture;
+    s_Stats.Issued++;
+    GLCall(glBindTexture(target, texture));
+}
+
+void GLStateCache::OnDeleteProgram(unsigned int program) {
+    if (s_State.Program == program)
+        s_State.Program = s_Unknown;
+}
+
+void GLStateCache::OnDeleteVertexArray(unsigned int vertexArray) {
+    if (s_State.VertexArray == vertexArray) {
+        s_State.VertexArray = 0;
+        s_State.ElementBuffer = s_Unknown;
+    }
+    s_State.ElementBufferPerVertexArray.erase(vertexArray);
+}
+
+void GLStateCache::OnDeleteBuffer(unsigned int buffer) {
+    for (unsigned int& bound : s_State.Buffers) {
+        if (bound == buffer)
+            bound = 0;
+    }
+    for (unsigned int i = 0; i < MaxBufferBindings; i++) {
+        if (s_State.UniformBindings[i] == buffer)
+            s_State.UniformBindings[i] = 0;
+        if (s_State.StorageBindings[i] == buffer)
+            s_State.StorageBindings[i] = 0;
+    }
+
+    if (s_State.ElementBuffer == buffer)
+        s_State.ElementBuffer = 0;
+
+    // Vertex arrays that are not bound keep their attachment, so the name can
+    // no longer be trusted for them
+    for (auto& [vertexArray, elementBuffer] : s_State.ElementBufferPerVertexArray) {
+        if (elementBuffer == buffer)
+            elementBuffer = vertexArray == s_State.VertexArray ? 0 : s_Unknown;
+    }
+}
+
+void GLStateCache::OnDeleteTexture(unsigned int texture) {
+    for (unsigned int& bound : s_State.Textures) {
+        if (bound == texture)
+            bound = 0;
+    }
+}
+
+void GLStateCache::Invalidate() {
+    s_State = GLState();
+}
+
+const GLStateCache::Stats& GLStateCache::GetStats() {
+    return s_Stats;
+}
+
+void GLStateCache::ResetStats() {
+    s_Stats = Stats();
+}
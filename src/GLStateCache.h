@@ -0,0 +1,38 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+// Shadows the GL bind state of the current context so binding an object that
+// is already bound costs nothing. Every bind in the renderer goes through here;
+// code that touches GL state behind its back must call Invalidate afterwards.
+class GLStateCache {
+public:
+    struct Stats {
+        unsigned int Issued = 0;
+        unsigned int Skipped = 0;
+    };
+
+    static constexpr unsigned int MaxTextureUnits = 32;
+    static constexpr unsigned int MaxBufferBindings = 16;
+
+    static void UseProgram(unsigned int program);
+    static void BindVertexArray(unsigned int vertexArray);
+    static void BindBuffer(unsigned int target, unsigned int buffer);
+    // Indexed binding for uniform and shader storage blocks; also sets the generic binding
+    static void BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer);
+    static void BindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+
+    // Deleting a bound object reverts its binding to 0 in GL, so the cache has
+    // to forget it before the name can be handed out again
+    static void OnDeleteProgram(unsigned int program);
+    static void OnDeleteVertexArray(unsigned int vertexArray);
+    static void OnDeleteBuffer(unsigned int buffer);
+    static void OnDeleteTexture(unsigned int texture);
+
+    static void Invalidate();
+
+    static const Stats& GetStats();
+    static void ResetStats();
+};
@@ -4,24 +4,62 @@
 
 #include "IndexBuffer.h"
 
+#include <utility>
+
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
 
-IndexBuffer::IndexBuffer(const unsigned int *data, unsigned int count) : m_count(count) {
+IndexBuffer::IndexBuffer(const unsigned int *data, unsigned int count) : m_count(count), m_Type(GL_UNSIGNED_INT) {
     ASSERT(sizeof(unsigned int) == sizeof(GLuint));
 
-    GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+    // Uploads go through the copy target, so creating an index buffer doesn't
+    // replace the element buffer of whichever vertex array is bound
+    m_RendererID = GLObjectPool::CreateBuffer();
+    GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+}
+
+IndexBuffer::IndexBuffer(const unsigned short *data, unsigned int count) : m_count(count), m_Type(GL_UNSIGNED_SHORT) {
+    m_RendererID = GLObjectPool::CreateBuffer();
+    GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, count * sizeof(unsigned short), data, GL_STATIC_DRAW));
+}
+
+IndexBuffer::IndexBuffer(unsigned int count) : m_count(count), m_Type(GL_UNSIGNED_INT) {
+    m_RendererID = GLObjectPool::CreateBuffer();
+    GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, count * sizeof(unsigned int), nullptr, GL_DYNAMIC_DRAW));
 }
 
 IndexBuffer::~IndexBuffer() {
-    GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLObjectPool::DestroyBuffer(m_RendererID);
+}
+
+IndexBuffer::IndexBuffer(IndexBuffer &&other) noexcept
+    : m_RendererID(std::exchange(other.m_RendererID, 0)), m_count(std::exchange(other.m_count, 0)), m_Type(other.m_Type) {
+}
+
+IndexBuffer &IndexBuffer::operator=(IndexBuffer &&other) noexcept {
+    if (this != &other) {
+        GLObjectPool::DestroyBuffer(m_RendererID);
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_count = std::exchange(other.m_count, 0);
+        m_Type = other.m_Type;
+    }
+    return *this;
+}
+
+void IndexBuffer::SetData(const unsigned int *data, unsigned int count, unsigned int offset) {
+    ASSERT(m_Type == GL_UNSIGNED_INT && offset + count <= m_count);
+    GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID);
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset * sizeof(unsigned int), count * sizeof(unsigned int), data));
 }
 
 void IndexBuffer::Bind() const {
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::Unbind() const {
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
@@ -8,13 +8,28 @@ class IndexBuffer {
 private:
     unsigned int m_RendererID{};
     unsigned int m_count{};
+    unsigned int m_Type; // GL_UNSIGNED_INT or GL_UNSIGNED_SHORT
 public:
     IndexBuffer(const unsigned int* data, unsigned int count);
+    // 16-bit indices, for meshes of up to 65536 vertices
+    IndexBuffer(const unsigned short* data, unsigned int count);
+    // Dynamic buffer with room for count indices, filled later through SetData
+    explicit IndexBuffer(unsigned int count);
     ~IndexBuffer();
 
+    IndexBuffer(const IndexBuffer&) = delete;
+    IndexBuffer& operator=(const IndexBuffer&) = delete;
+    IndexBuffer(IndexBuffer&& other) noexcept;
+    IndexBuffer& operator=(IndexBuffer&& other) noexcept;
+
+    // 32-bit buffers only; offset and count are in indices, not bytes
+    void SetData(const unsigned int* data, unsigned int count, unsigned int offset = 0);
+
     void Bind() const;
     void Unbind() const;
 
     inline unsigned int GetCount() const { return m_count; }
+    inline unsigned int GetType() const { return m_Type; }
+    inline unsigned int GetRendererID() const { return m_RendererID; }
 };
 
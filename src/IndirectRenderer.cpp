@@ -0,0 +1,262 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "IndirectRenderer.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
+#include "Profiler.h"
+#include "Texture.h"
+#include "VertexBufferLayout.h"
+
+static constexpr unsigned int CullGroupSize = 64;
+
+IndirectRenderer::IndirectRenderer(MeshPool &meshes, unsigned int initialCapacity)
+    : m_Meshes(meshes), m_ModelBuffer(initialCapacity * static_cast<unsigned int>(sizeof(glm::mat4))) {
+    if (GLEW_VERSION_4_3)
+        m_SupportedPath = Path::GpuDriven;
+    else if (GLEW_ARB_multi_draw_indirect && GLEW_ARB_draw_indirect && GLEW_ARB_base_instance)
+        m_SupportedPath = Path::CpuIndirect;
+    else
+        m_SupportedPath = Path::CpuFallback;
+
+    if (m_SupportedPath == Path::GpuDriven) {
+        m_CullShader = std::make_unique<Shader>("res/shaders/CullDraws.shader");
+        if (!m_CullShader->IsValid())
+            m_SupportedPath = Path::CpuIndirect;
+    }
+    m_Path = m_SupportedPath;
+    m_VertexArrayPath = m_Path;
+
+    m_CommandBuffer = GLObjectPool::CreateBuffer();
+    m_InputBuffer = GLObjectPool::CreateBuffer();
+    m_CountBuffer = GLObjectPool::CreateBuffer();
+}
+
+IndirectRenderer::~IndirectRenderer() {
+    GLObjectPool::DestroyBuffer(m_CommandBuffer);
+    GLObjectPool::DestroyBuffer(m_InputBuffer);
+    GLObjectPool::DestroyBuffer(m_CountBuffer);
+}
+
+void IndirectRenderer::Submit(MeshHandle mesh, const Shader &shader, const Texture *texture, const glm::mat4 &model, const AABB &bounds) {
+    const uint64_t material = static_cast<uint64_t>(shader.GetRendererID()) << 32 | (texture ? texture->GetRendererID() : 0);
+    m_Submissions.push_back({ material, mesh, &shader, texture, model, bounds });
+}
+
+void IndirectRenderer::SetPath(Path path) {
+    // Paths are declared from most to least capable
+    m_Path = static_cast<int>(path) < static_cast<int>(m_SupportedPath) ? m_SupportedPath : path;
+}
+
+void IndirectRenderer::Flush(const glm::mat4 &viewProjection) {
+    m_Stats = {};
+    m_Stats.Submitted = static_cast<unsigned int>(m_Submissions.size());
+    if (m_Submissions.empty())
+        return;
+
+    PROFILE_GPU_SCOPE("IndirectRenderer::Flush");
+    const Frustum frustum(viewProjection);
+    SortIntoBuckets();
+    m_Stats.Buckets = static_cast<unsigned int>(m_Buckets.size());
+
+    if (m_Path == Path::GpuDriven) {
+        CullOnGpu(frustum);
+        DrawIndirect(true);
+    } else {
+        CullOnCpu(frustum);
+        if (m_Path == Path::CpuIndirect) {
+            PrepareVertexArray(static_cast<unsigned int>(m_Models.size()));
+            m_ModelBuffer.SetData(m_Models.data(), static_cast<unsigned int>(m_Models.size() * sizeof(glm::mat4)));
+            GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer);
+            GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Commands.size() * sizeof(DrawCommand), m_Commands.data(), GL_STREAM_DRAW));
+            DrawIndirect(false);
+        } else {
+            PrepareVertexArray(0);
+            DrawFallback();
+        }
+    }
+    m_Submissions.clear();
+}
+
+// Groups the submissions by material, keeping submission order inside a group
+void IndirectRenderer::SortIntoBuckets() {
+    m_Order.resize(m_Submissions.size());
+    std::iota(m_Order.begin(), m_Order.end(), 0u);
+    std::stable_sort(m_Order.begin(), m_Order.end(),
+                     [&](uint32_t a, uint32_t b) { return m_Submissions[a].Material < m_Submissions[b].Material; });
+
+    m_Buckets.clear();
+    for (unsigned int i = 0; i < m_Order.size(); i++) {
+        const Submission& submission = m_Submissions[m_Order[i]];
+        if (m_Buckets.empty() || m_Submissions[m_Order[m_Buckets.back().Start]].Material != submission.Material)
+            m_Buckets.push_back({ submission.Program, submission.Image, i, 0, 0, 0 });
+        m_Buckets.back().Count++;
+    }
+}
+
+void IndirectRenderer::CullOnCpu(const Frustum &frustum) {
+    m_Commands.clear();
+    m_Models.clear();
+    for (Bucket& bucket : m_Buckets) {
+        bucket.FirstCommand = static_cast<unsigned int>(m_Commands.size());
+        for (unsigned int i = bucket.Start; i < bucket.Start + bucket.Count; i++) {
+            const Submission& submission = m_Submissions[m_Order[i]];
+            const MeshRange* range = m_Meshes.Get(submission.Mesh);
+            if (!range || !frustum.Intersects(submission.Bounds.Transformed(submission.Model)))
+                continue;
+
+            const auto slot = static_cast<unsigned int>(m_Models.size());
+            m_Commands.push_back({ range->IndexCount, 1, range->FirstIndex, static_cast<int>(range->BaseVertex), slot });
+            m_Models.push_back(submission.Model);
+        }
+        bucket.Visible = static_cast<unsigned int>(m_Commands.size()) - bucket.FirstCommand;
+        m_Stats.Visible += bucket.Visible;
+    }
+}
+
+// Every submission owns a command slot; the shader fills each bucket's slots
+// from the front with its visible draws and leaves the rest zeroed, which GL
+// skips as empty draws.
+void IndirectRenderer::CullOnGpu(const Frustum &frustum) {
+    const auto count = static_cast<unsigned int>(m_Submissions.size());
+    m_Inputs.resize(count);
+    for (unsigned int b = 0; b < m_Buckets.size(); b++) {
+        const Bucket& bucket = m_Buckets[b];
+        for (unsigned int i = bucket.Start; i < bucket.Start + bucket.Count; i++) {
+            const Submission& submission = m_Submissions[m_Order[i]];
+            const MeshRange* range = m_Meshes.Get(submission.Mesh);
+            DrawInput& input = m_Inputs[i];
+            input.Model = submission.Model;
+            input.BoundsMin = glm::vec4(submission.Bounds.Min, 1.0f);
+            input.BoundsMax = glm::vec4(submission.Bounds.Max, 1.0f);
+            input.IndexCount = range ? range->IndexCount : 0;
+            input.FirstIndex = range ? range->FirstIndex : 0;
+            input.BaseVertex = range ? range->BaseVertex : 0;
+            input.Bucket = b;
+            input.BucketStart = bucket.Start;
+        }
+    }
+
+    PrepareVertexArray(count);
+
+    GLStateCache::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_InputBuffer);
+    GLCall(glBufferData(GL_SHADER_STORAGE_BUFFER, count * sizeof(DrawInput), m_Inputs.data(), GL_STREAM_DRAW));
+    GLStateCache::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_CountBuffer);
+    GLCall(glBufferData(GL_SHADER_STORAGE_BUFFER, m_Buckets.size() * sizeof(unsigned int), nullptr, GL_STREAM_DRAW));
+    GLCall(glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr));
+    GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer);
+    GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, count * sizeof(DrawCommand), nullptr, GL_STREAM_DRAW));
+    GLCall(glClearBufferData(GL_DRAW_INDIRECT_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr));
+
+    GLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_InputBuffer);
+    GLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_CommandBuffer);
+    GLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_ModelBuffer.GetRendererID());
+    GLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_CountBuffer);
+
+    glm::vec4 planes[6];
+    for (int i = 0; i < 6; i++)
+        planes[i] = frustum.GetPlane(i);
+    m_CullShader->Bind();
+    m_CullShader->SetUniform4fv("u_Planes", 6, &planes[0].x);
+    m_CullShader->SetUniform1i("u_DrawCount", static_cast<int>(count));
+    m_CullShader->Dispatch((count + CullGroupSize - 1) / CullGroupSize);
+
+    // The commands, counts and models are read by the draws that follow
+    GLCall(glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT));
+}
+
+void IndirectRenderer::DrawIndirect(bool gpuCounts) {
+    m_VertexArray.Bind();
+    GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer);
+
+    // With the counts the GPU wrote, the empty tail of each bucket is never walked
+    bool useCounts = false;
+#ifdef GL_ARB_indirect_parameters
+    if (GLEW_ARB_indirect_parameters) {
+        useCounts = gpuCounts;
+        // Left bound, some drivers read it for the plain multi-draws as well
+        GLStateCache::BindBuffer(GL_PARAMETER_BUFFER_ARB, useCounts ? m_CountBuffer : 0);
+    }
+#endif
+
+    for (unsigned int b = 0; b < m_Buckets.size(); b++) {
+        const Bucket& bucket = m_Buckets[b];
+        const unsigned int first = gpuCounts ? bucket.Start : bucket.FirstCommand;
+        const unsigned int drawCount = gpuCounts ? bucket.Count : bucket.Visible;
+        if (drawCount == 0)
+            continue;
+
+        bucket.Program->Bind();
+        if (bucket.Image)
+            bucket.Image->Bind();
+        const auto* offset = reinterpret_cast<const void*>(first * sizeof(DrawCommand));
+        if (useCounts) {
+#ifdef GL_ARB_indirect_parameters
+            GLCall(glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_INT, offset,
+                                                       b * sizeof(unsigned int), static_cast<int>(drawCount), 0));
+#endif
+        } else {
+            GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, static_cast<int>(drawCount), 0));
+        }
+        m_Stats.DrawCalls++;
+    }
+}
+
+// No baseInstance in GL 3.3, so each draw sets its model as the current value
+// of the attribute locations the instanced array would have fed
+void IndirectRenderer::DrawFallback() {
+    m_VertexArray.Bind();
+    const unsigned int modelLocation = m_VertexArray.GetAttribCount();
+    for (const Bucket& bucket : m_Buckets) {
+        if (bucket.Visible == 0)
+            continue;
+
+        bucket.Program->Bind();
+        if (bucket.Image)
+            bucket.Image->Bind();
+        for (unsigned int c = bucket.FirstCommand; c < bucket.FirstCommand + bucket.Visible; c++) {
+            const DrawCommand& command = m_Commands[c];
+            const glm::mat4& model = m_Models[c];
+            for (unsigned int column = 0; column < 4; column++) {
+                GLCall(glVertexAttrib4fv(modelLocation + column, &model[static_cast<int>(column)][0]));
+            }
+            GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<int>(command.Count), GL_UNSIGNED_INT,
+                                            reinterpret_cast<const void*>(command.FirstIndex * sizeof(unsigned int)), command.BaseVertex));
+            m_Stats.DrawCalls++;
+        }
+    }
+}
+
+// The vertex array reads the pool's mesh buffers plus, on the indirect paths,
+// the model buffer, so it is rebuilt whenever either is replaced
+void IndirectRenderer::PrepareVertexArray(unsigned int modelCount) {
+    bool rebuild = m_VertexArraySource != m_Meshes.GetVertexBuffer().GetRendererID() || m_VertexArrayPath != m_Path;
+
+    const auto modelSize = modelCount * static_cast<unsigned int>(sizeof(glm::mat4));
+    if (modelSize > m_ModelBuffer.GetSize()) {
+        m_ModelBuffer = VertexBuffer(std::max(modelSize, m_ModelBuffer.GetSize() * 2));
+        rebuild = true;
+    }
+    if (!rebuild)
+        return;
+
+    VertexArray vertexArray;
+    vertexArray.AddBuffer(m_Meshes.GetVertexBuffer(), m_Meshes.GetLayout());
+    if (m_Path != Path::CpuFallback) {
+        VertexBufferLayout modelLayout;
+        modelLayout.Push<glm::mat4>(1, 1);
+        vertexArray.AddBuffer(m_ModelBuffer, modelLayout);
+    }
+    m_Meshes.GetIndexBuffer().Bind();
+
+    m_VertexArray = std::move(vertexArray);
+    m_VertexArraySource = m_Meshes.GetVertexBuffer().GetRendererID();
+    m_VertexArrayPath = m_Path;
+}
@@ -0,0 +1,129 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Culling.h"
+#include "MeshPool.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+class Texture;
+
+// Draws MeshPool meshes with one call per material (shader and texture)
+// instead of one per mesh. Each draw's model matrix reaches the vertex shader
+// as a per-instance mat4 attribute right after the mesh attributes, the way
+// Instanced.shader reads it, selected by the draw's baseInstance.
+//
+//  GpuDriven    GL 4.3: a compute pass frustum culls the draws and compacts
+//               the visible ones into a GL_DRAW_INDIRECT_BUFFER, so the CPU
+//               only uploads the submissions and issues
+//               glMultiDrawElementsIndirect per material.
+//  CpuIndirect  GL 4.3 without the compute pass: culled and compacted on
+//               the CPU, drawn the same way.
+//  CpuFallback  GL 3.3: culled on the CPU, one glDrawElementsBaseVertex per
+//               visible draw with the model set as a constant attribute.
+class IndirectRenderer {
+public:
+    enum class Path {
+        GpuDriven, CpuIndirect, CpuFallback
+    };
+
+    struct Stats {
+        unsigned int Submitted = 0;
+        unsigned int Buckets = 0;
+        unsigned int DrawCalls = 0;
+        // Unknown on the CPU for GpuDriven, which never reads its counts back
+        unsigned int Visible = 0;
+    };
+
+    // Matches the GL DrawElementsIndirectCommand layout
+    struct DrawCommand {
+        unsigned int Count;
+        unsigned int InstanceCount;
+        unsigned int FirstIndex;
+        int BaseVertex;
+        unsigned int BaseInstance;
+    };
+
+private:
+    // Matches DrawInput in CullDraws.shader (std430)
+    struct DrawInput {
+        glm::mat4 Model;
+        glm::vec4 BoundsMin;
+        glm::vec4 BoundsMax;
+        unsigned int IndexCount, FirstIndex, BaseVertex, Bucket;
+        unsigned int BucketStart, Padding[3];
+    };
+
+    struct Submission {
+        uint64_t Material;
+        MeshHandle Mesh;
+        const Shader* Program;
+        const Texture* Image;
+        glm::mat4 Model;
+        AABB Bounds;
+    };
+
+    struct Bucket {
+        const Shader* Program;
+        const Texture* Image;
+        unsigned int Start;        // First submission in m_Order, and first command slot on GpuDriven
+        unsigned int Count;        // Submissions in the bucket
+        unsigned int FirstCommand; // The CPU paths compact the visible draws into m_Commands
+        unsigned int Visible;
+    };
+
+    MeshPool& m_Meshes;
+    Path m_Path;
+    Path m_SupportedPath;
+    std::unique_ptr<Shader> m_CullShader;
+
+    VertexArray m_VertexArray;
+    VertexBuffer m_ModelBuffer;
+    unsigned int m_VertexArraySource = 0; // Mesh vertex buffer m_VertexArray was built for
+    Path m_VertexArrayPath;
+    unsigned int m_CommandBuffer = 0;
+    unsigned int m_InputBuffer = 0;
+    unsigned int m_CountBuffer = 0;
+
+    std::vector<Submission> m_Submissions;
+    std::vector<uint32_t> m_Order;
+    std::vector<Bucket> m_Buckets;
+    std::vector<DrawInput> m_Inputs;
+    std::vector<DrawCommand> m_Commands;
+    std::vector<glm::mat4> m_Models;
+    Stats m_Stats;
+public:
+    explicit IndirectRenderer(MeshPool& meshes, unsigned int initialCapacity = 4096);
+    ~IndirectRenderer();
+
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    // bounds are in mesh space; draws whose transformed bounds miss the frustum are skipped
+    void Submit(MeshHandle mesh, const Shader& shader, const Texture* texture, const glm::mat4& model, const AABB& bounds);
+    // Culls against viewProjection and draws everything submitted since the last Flush
+    void Flush(const glm::mat4& viewProjection);
+
+    // Paths above the one the context supports fall back to it
+    void SetPath(Path path);
+    inline Path GetPath() const { return m_Path; }
+    inline Path GetSupportedPath() const { return m_SupportedPath; }
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    void SortIntoBuckets();
+    void CullOnCpu(const Frustum& frustum);
+    void CullOnGpu(const Frustum& frustum);
+    void DrawIndirect(bool gpuCounts);
+    void DrawFallback();
+    void PrepareVertexArray(unsigned int modelCount);
+};
@@ -0,0 +1,156 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+
+static std::atomic<uint64_t> s_NextSystemID{ 1 };
+
+// The queue this thread owns in the system it belongs to
+struct WorkerIdentity {
+    uint64_t SystemID = 0;
+    unsigned int Index = 0;
+};
+static thread_local WorkerIdentity t_Worker;
+
+JobSystem::JobSystem(unsigned int workerCount) : m_ID(s_NextSystemID.fetch_add(1, std::memory_order_relaxed)) {
+    if (workerCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 0;
+    }
+
+    for (unsigned int i = 0; i <= workerCount; i++)
+        m_Queues.push_back(std::make_unique<WorkerQueue>());
+    for (unsigned int i = 1; i <= workerCount; i++)
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Stopping = true;
+    }
+    m_WorkAvailable.notify_all();
+    for (std::thread& worker : m_Workers)
+        worker.join();
+}
+
+unsigned int JobSystem::GetThreadIndex() const {
+    return t_Worker.SystemID == m_ID ? t_Worker.Index : 0;
+}
+
+void JobSystem::Run(Job job, JobCounter *counter) {
+    if (counter)
+        counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+    WorkerQueue& queue = *m_Queues[GetThreadIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Tasks.push_back({ std::move(job), counter });
+    }
+    m_Queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this against a worker between its check and its wait
+    { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+    m_WorkAvailable.notify_one();
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)> &body) {
+    if (count == 0)
+        return;
+    if (batchSize == 0)
+        batchSize = 1;
+    if (count <= batchSize || m_Workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = 0; begin < count; begin += batchSize) {
+        const size_t end = std::min(begin + batchSize, count);
+        Run([&body, begin, end] { body(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::Wait(const JobCounter &counter) {
+    const unsigned int index = GetThreadIndex();
+    while (!counter.IsDone()) {
+        if (!RunOne(index))
+            std::this_thread::yield();
+    }
+}
+
+JobSystem::Stats JobSystem::GetStats() const {
+    return { m_Executed.load(std::memory_order_relaxed), m_Stolen.load(std::memory_order_relaxed) };
+}
+
+void JobSystem::ResetStats() {
+    m_Executed.store(0, std::memory_order_relaxed);
+    m_Stolen.store(0, std::memory_order_relaxed);
+}
+
+void JobSystem::WorkerLoop(unsigned int index) {
+    t_Worker = { m_ID, index };
+    Profiler::SetThreadName("JobWorker");
+
+    while (true) {
+        if (RunOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_WorkAvailable.wait(lock, [this] { return m_Stopping || m_Queued.load(std::memory_order_acquire) > 0; });
+        if (m_Stopping)
+            return;
+    }
+}
+
+bool JobSystem::RunOne(unsigned int index) {
+    Task task;
+    if (!Pop(index, task) && !Steal(index, task))
+        return false;
+    Execute(task);
+    return true;
+}
+
+// Newest first, while its data is still in cache
+bool JobSystem::Pop(unsigned int index, Task &task) {
+    WorkerQueue& queue = *m_Queues[index];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (queue.Tasks.empty())
+        return false;
+
+    task = std::move(queue.Tasks.back());
+    queue.Tasks.pop_back();
+    m_Queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Oldest first, which tends to be the largest piece of work left
+bool JobSystem::Steal(unsigned int thief, Task &task) {
+    const auto count = static_cast<unsigned int>(m_Queues.size());
+    for (unsigned int i = 1; i < count; i++) {
+        WorkerQueue& queue = *m_Queues[(thief + i) % count];
+        std::unique_lock<std::mutex> lock(queue.Mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.Tasks.empty())
+            continue;
+
+        task = std::move(queue.Tasks.front());
+        queue.Tasks.pop_front();
+        m_Queued.fetch_sub(1, std::memory_order_relaxed);
+        m_Stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Task &task) {
+    task.Function();
+    m_Executed.fetch_add(1, std::memory_order_relaxed);
+    if (task.Counter)
+        task.Counter->m_Pending.fetch_sub(1, std::memory_order_release);
+}
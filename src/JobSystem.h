@@ -0,0 +1,91 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Jobs of one group still to finish. Every job started with the counter
+// raises it and lowers it again once it ran.
+class JobCounter {
+private:
+    std::atomic<unsigned int> m_Pending{ 0 };
+public:
+    inline bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+    friend class JobSystem;
+};
+
+// Plain task scheduler with work stealing. Every thread has its own deque: it
+// pushes and pops its jobs at the back, and threads that run dry steal from
+// the front of the others. The thread that created the system owns queue 0,
+// as does any other thread outside it, and Wait runs jobs instead of blocking,
+// so the render thread helps out until what it needs is done.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    struct Stats {
+        unsigned int Executed = 0;
+        unsigned int Stolen = 0;
+    };
+private:
+    struct Task {
+        Job Function;
+        JobCounter* Counter;
+    };
+
+    // Own cache line each, so threads working their own queue don't contend
+    struct alignas(64) WorkerQueue {
+        std::mutex Mutex;
+        std::deque<Task> Tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+    std::vector<std::thread> m_Workers;
+    std::mutex m_SleepMutex;
+    std::condition_variable m_WorkAvailable;
+    std::atomic<unsigned int> m_Queued{ 0 };
+    std::atomic<unsigned int> m_Executed{ 0 };
+    std::atomic<unsigned int> m_Stolen{ 0 };
+    bool m_Stopping = false;
+    uint64_t m_ID;
+public:
+    // workerCount 0 uses one thread per core, minus the calling thread
+    explicit JobSystem(unsigned int workerCount = 0);
+    // Jobs still queued are dropped; wait on their counters first
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Run(Job job, JobCounter* counter = nullptr);
+    // Calls body(begin, end) over [0, count) in batches of batchSize and returns once all ran
+    void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& body);
+    // Runs queued jobs on the calling thread until the counter is done
+    void Wait(const JobCounter& counter);
+
+    // Workers plus the thread that created the system
+    inline unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_Queues.size()); }
+    // 0 on threads outside the system, so it can index per-thread data
+    unsigned int GetThreadIndex() const;
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    void WorkerLoop(unsigned int index);
+    bool RunOne(unsigned int index);
+    bool Pop(unsigned int index, Task& task);
+    bool Steal(unsigned int thief, Task& task);
+    void Execute(Task& task);
+};
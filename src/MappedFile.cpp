@@ -0,0 +1,103 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "MappedFile.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return;
+    }
+
+    m_Data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_Data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    m_Size = static_cast<size_t>(size.QuadPart);
+    m_File = file;
+    m_Mapping = mapping;
+}
+
+MappedFile::~MappedFile() {
+    if (m_Data)
+        UnmapViewOfFile(m_Data);
+    if (m_Mapping)
+        CloseHandle(m_Mapping);
+    if (m_File)
+        CloseHandle(m_File);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            m_Data = static_cast<const unsigned char*>(data);
+            m_Size = static_cast<size_t>(info.st_size);
+        }
+    }
+
+    // The mapping keeps the file alive on its own
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (m_Data)
+        munmap(const_cast<unsigned char*>(m_Data), m_Size);
+}
+
+#endif
+
+void MappedFile::Prefetch(size_t offset, size_t size) const {
+    if (!m_Data || offset >= m_Size)
+        return;
+    const size_t end = std::min(m_Size, offset + size);
+
+#ifndef _WIN32
+    // Starts readahead for the whole range before touching it page by page
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t alignedOffset = offset / pageSize * pageSize;
+    madvise(const_cast<unsigned char*>(m_Data) + alignedOffset, end - alignedOffset, MADV_WILLNEED);
+#endif
+
+    constexpr size_t PageStride = 4096;
+    volatile unsigned char sink = 0;
+    for (size_t i = offset; i < end; i += PageStride)
+        sink = sink + m_Data[i];
+    sink = sink + m_Data[end - 1];
+}
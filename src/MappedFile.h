@@ -0,0 +1,35 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are faulted in on first
+// touch, so data can go from disk to GL without an intermediate copy.
+class MappedFile {
+private:
+    const unsigned char* m_Data{};
+    size_t m_Size{};
+#ifdef _WIN32
+    void* m_File{};
+    void* m_Mapping{};
+#endif
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    inline bool IsValid() const { return m_Data != nullptr; }
+    inline const unsigned char* GetData() const { return m_Data; }
+    inline size_t GetSize() const { return m_Size; }
+
+    // Reads one byte of every page in the range, so later reads of it (like a
+    // glBufferData on the render thread) don't stall on the disk
+    void Prefetch(size_t offset, size_t size) const;
+};
@@ -0,0 +1,40 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "Mesh.h"
+
+#include "Renderer.h"
+
+Mesh::Mesh(unsigned int expectedChunks)
+    : m_ExpectedChunks(expectedChunks) {}
+
+Mesh::Mesh(const MeshData &data)
+    : m_ExpectedChunks(static_cast<unsigned int>(data.GetChunks().size())) {
+    m_Parts.reserve(data.GetChunks().size());
+    for (const MeshChunk& chunk : data.GetChunks())
+        AddChunk(data.GetLayout(), chunk);
+}
+
+void Mesh::AddChunk(const VertexBufferLayout &layout, const MeshChunk &chunk) {
+    Part& part = m_Parts.emplace_back(Part{
+        VertexBuffer(chunk.Vertices, chunk.VertexCount * layout.GetStride()),
+        chunk.IndexType == GL_UNSIGNED_SHORT ? IndexBuffer(static_cast<const unsigned short*>(chunk.Indices), chunk.IndexCount)
+                                             : IndexBuffer(static_cast<const unsigned int*>(chunk.Indices), chunk.IndexCount),
+        VertexArray(),
+        chunk.Bounds
+    });
+    part.Array.AddBuffer(part.Vertices, layout);
+
+    if (m_Parts.size() == 1) {
+        m_Bounds = chunk.Bounds;
+    } else {
+        m_Bounds.Min = glm::min(m_Bounds.Min, chunk.Bounds.Min);
+        m_Bounds.Max = glm::max(m_Bounds.Max, chunk.Bounds.Max);
+    }
+}
+
+void Mesh::Draw(const Renderer &renderer, const Shader &shader) const {
+    for (const Part& part : m_Parts)
+        renderer.Draw(part.Array, part.Indices, shader);
+}
@@ -0,0 +1,51 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "Culling.h"
+#include "IndexBuffer.h"
+#include "MeshData.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+class Renderer;
+class Shader;
+
+// A mesh on the GPU, one buffer pair per chunk of its MeshData. Chunks can be
+// added one at a time, so a streamed mesh draws whatever has arrived so far.
+class Mesh {
+private:
+    struct Part {
+        VertexBuffer Vertices;
+        IndexBuffer Indices;
+        VertexArray Array;
+        AABB Bounds;
+    };
+
+    std::vector<Part> m_Parts;
+    unsigned int m_ExpectedChunks{};
+    AABB m_Bounds{ glm::vec3(0.0f), glm::vec3(0.0f) };
+
+public:
+    // Empty until chunks are added, for streaming
+    explicit Mesh(unsigned int expectedChunks = 0);
+    // Uploads every chunk right away
+    explicit Mesh(const MeshData& data);
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    // Uploads straight from the chunk's bytes, which may be a file mapping
+    void AddChunk(const VertexBufferLayout& layout, const MeshChunk& chunk);
+    void SetExpectedChunks(unsigned int count) { m_ExpectedChunks = count; }
+
+    void Draw(const Renderer& renderer, const Shader& shader) const;
+
+    inline bool IsLoaded() const { return m_Parts.size() >= m_ExpectedChunks; }
+    inline unsigned int GetChunkCount() const { return static_cast<unsigned int>(m_Parts.size()); }
+    inline const AABB& GetBounds() const { return m_Bounds; }
+};
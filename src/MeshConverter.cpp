@@ -0,0 +1,34 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include <iostream>
+
+#include "MeshData.h"
+
+// Converts a Wavefront OBJ into the binary mesh format MeshData::Load maps
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cout << "Usage: " << argv[0] << " input.obj output.mesh" << std::endl;
+        return 1;
+    }
+
+    const MeshData data = MeshData::ImportObj(argv[1]);
+    if (!data.IsValid()) {
+        std::cout << "Nothing to convert in '" << argv[1] << "'" << std::endl;
+        return 1;
+    }
+    if (!data.Save(argv[2])) {
+        std::cout << "Failed to write '" << argv[2] << "'" << std::endl;
+        return 1;
+    }
+
+    unsigned int vertices = 0, indices = 0;
+    for (const MeshChunk& chunk : data.GetChunks()) {
+        vertices += chunk.VertexCount;
+        indices += chunk.IndexCount;
+    }
+    std::cout << "Wrote " << data.GetChunks().size() << " chunks, " << vertices << " vertices, "
+              << indices / 3 << " triangles (" << data.GetLayout().GetStride() << " bytes per vertex)" << std::endl;
+    return 0;
+}
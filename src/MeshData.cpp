@@ -0,0 +1,434 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "MeshData.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+#include "Profiler.h"
+
+static constexpr char s_MeshMagic[4] = { 'M', 'O', 'G', 'M' };
+static constexpr unsigned int s_MeshVersion = 2;
+// Blobs start on this boundary, so mapped indices are aligned
+static constexpr size_t s_BlobAlignment = 16;
+
+struct MeshFileHeader {
+    char Magic[4];
+    unsigned int Version;
+    unsigned int ElementCount;
+    unsigned int Stride;
+    unsigned int ChunkCount;
+};
+
+struct MeshFileElement {
+    unsigned int Type;
+    unsigned int Count;
+    unsigned int Normalized;
+    unsigned int Integer;
+};
+
+struct MeshFileChunk {
+    uint64_t VertexOffset;
+    uint64_t IndexOffset;
+    unsigned int VertexCount;
+    unsigned int IndexCount;
+    unsigned int IndexType;  // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    unsigned int Reserved;   // Zero; keeps the entry free of padding
+    float Min[3];
+    float Max[3];
+};
+
+static size_t AlignBlob(size_t offset) {
+    return (offset + s_BlobAlignment - 1) / s_BlobAlignment * s_BlobAlignment;
+}
+
+template<typename Index>
+static unsigned int MaxIndex(const Index* indices, unsigned int count) {
+    Index maximum = 0;
+    for (unsigned int i = 0; i < count; i++)
+        maximum = std::max(maximum, indices[i]);
+    return maximum;
+}
+
+// One face corner as written in the file, already 0-based; -1 where the
+// corner has no texture coordinate or normal
+struct ObjCorner {
+    int Position;
+    int TexCoord;
+    int Normal;
+
+    bool operator==(const ObjCorner&) const = default;
+};
+
+struct ObjCornerHash {
+    size_t operator()(const ObjCorner& corner) const {
+        uint64_t hash = static_cast<uint32_t>(corner.Position);
+        hash = hash * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(corner.TexCoord);
+        hash = hash * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(corner.Normal);
+        return static_cast<size_t>(hash ^ hash >> 29);
+    }
+};
+
+static const char* SkipSpaces(const char* current, const char* end) {
+    while (current < end && (*current == ' ' || *current == '\t' || *current == '\r'))
+        current++;
+    return current;
+}
+
+static bool ReadFloats(const char* current, const char* end, float* values, int count) {
+    for (int i = 0; i < count; i++) {
+        current = SkipSpaces(current, end);
+        const auto result = std::from_chars(current, end, values[i]);
+        if (result.ec != std::errc())
+            return false;
+        current = result.ptr;
+    }
+    return true;
+}
+
+// OBJ indices are 1-based, or negative to count back from the last element read
+static bool ResolveIndex(long index, size_t count, int& resolved) {
+    const long value = index < 0 ? static_cast<long>(count) + index : index - 1;
+    if (value < 0 || value >= static_cast<long>(count))
+        return false;
+    resolved = static_cast<int>(value);
+    return true;
+}
+
+// Vertices of the chunk being built, deduplicated by corner
+struct ObjChunkBuilder {
+    std::vector<float> Positions;
+    std::vector<float> TexCoords;
+    std::vector<float> Normals;
+    std::vector<unsigned int> Indices;
+    std::unordered_map<ObjCorner, unsigned int, ObjCornerHash> Vertices;
+};
+
+struct ChunkPlacement {
+    size_t VertexOffset;
+    size_t IndexOffset;
+    unsigned int VertexCount;
+    unsigned int IndexCount;
+    unsigned int IndexType;
+    AABB Bounds;
+};
+
+MeshData MeshData::ImportObj(const std::string &path) {
+    PROFILE_SCOPE("MeshData::ImportObj");
+    MeshData data;
+    const MappedFile file(path);
+    if (!file.IsValid()) {
+        std::cout << "Failed to open mesh '" << path << "'" << std::endl;
+        return data;
+    }
+
+    // First pass keeps the attribute pools and the faces, since whether there
+    // are texture coordinates or normals decides the layout
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<ObjCorner> corners;
+    std::vector<unsigned int> faceSizes;
+    std::vector<size_t> groupStarts; // First face of every object or group
+
+    const auto* text = reinterpret_cast<const char*>(file.GetData());
+    const char* const end = text + file.GetSize();
+    unsigned int lineNumber = 0;
+    for (const char* line = text; line < end;) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!lineEnd)
+            lineEnd = end;
+        lineNumber++;
+
+        const char* current = SkipSpaces(line, lineEnd);
+        const char* keyword = current;
+        while (current < lineEnd && *current != ' ' && *current != '\t')
+            current++;
+        const std::string_view command(keyword, current - keyword);
+
+        bool valid = true;
+        if (command == "v") {
+            glm::vec3& position = positions.emplace_back();
+            valid = ReadFloats(current, lineEnd, &position.x, 3);
+        } else if (command == "vt") {
+            glm::vec2& texCoord = texCoords.emplace_back();
+            valid = ReadFloats(current, lineEnd, &texCoord.x, 2);
+        } else if (command == "vn") {
+            glm::vec3& normal = normals.emplace_back();
+            valid = ReadFloats(current, lineEnd, &normal.x, 3);
+        } else if (command == "o" || command == "g") {
+            groupStarts.push_back(faceSizes.size());
+        } else if (command == "f") {
+            unsigned int size = 0;
+            while (valid) {
+                current = SkipSpaces(current, lineEnd);
+                if (current >= lineEnd)
+                    break;
+
+                long indices[3] = { 0, 0, 0 };
+                for (int component = 0; component < 3 && valid; component++) {
+                    if (component > 0) {
+                        if (current >= lineEnd || *current != '/')
+                            break;
+                        current++;
+                        if (current < lineEnd && *current == '/')
+                            continue;
+                    }
+                    const auto result = std::from_chars(current, lineEnd, indices[component]);
+                    valid = result.ec == std::errc();
+                    current = result.ptr;
+                }
+
+                ObjCorner corner{ -1, -1, -1 };
+                valid = valid && ResolveIndex(indices[0], positions.size(), corner.Position)
+                              && (indices[1] == 0 || ResolveIndex(indices[1], texCoords.size(), corner.TexCoord))
+                              && (indices[2] == 0 || ResolveIndex(indices[2], normals.size(), corner.Normal));
+                corners.push_back(corner);
+                size++;
+            }
+            valid = valid && size >= 3;
+            faceSizes.push_back(size);
+        }
+
+        if (!valid) {
+            std::cout << "Failed to parse mesh '" << path << "' at line " << lineNumber << std::endl;
+            return data;
+        }
+        line = lineEnd + 1;
+    }
+
+    const bool hasTexCoords = !texCoords.empty();
+    const bool hasNormals = !normals.empty();
+    data.m_Layout.Push<float>(3);
+    if (hasTexCoords)
+        data.m_Layout.Push<HalfFloat>(2);
+    if (hasNormals)
+        data.m_Layout.Push<PackedNormal>(1);
+    const unsigned int stride = data.m_Layout.GetStride();
+
+    std::vector<ChunkPlacement> placements;
+    ObjChunkBuilder builder;
+    const auto flush = [&] {
+        if (builder.Indices.empty())
+            return;
+
+        const auto vertexCount = static_cast<unsigned int>(builder.Vertices.size());
+        ChunkPlacement placement{};
+        placement.VertexOffset = AlignBlob(data.m_Storage.size());
+        placement.IndexOffset = AlignBlob(placement.VertexOffset + static_cast<size_t>(vertexCount) * stride);
+        placement.VertexCount = vertexCount;
+        placement.IndexCount = static_cast<unsigned int>(builder.Indices.size());
+        placement.IndexType = vertexCount <= MaxChunkVertices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        const size_t indexSize = placement.IndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+        data.m_Storage.resize(placement.IndexOffset + builder.Indices.size() * indexSize);
+
+        unsigned char* vertices = data.m_Storage.data() + placement.VertexOffset;
+        placement.Bounds = { glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()) };
+        for (unsigned int i = 0; i < vertexCount; i++) {
+            std::memcpy(vertices + static_cast<size_t>(i) * stride, &builder.Positions[i * 3], 3 * sizeof(float));
+            const glm::vec3 position(builder.Positions[i * 3], builder.Positions[i * 3 + 1], builder.Positions[i * 3 + 2]);
+            placement.Bounds.Min = glm::min(placement.Bounds.Min, position);
+            placement.Bounds.Max = glm::max(placement.Bounds.Max, position);
+        }
+        size_t offset = 3 * sizeof(float);
+        if (hasTexCoords) {
+            VertexPacking::PackHalf(builder.TexCoords.data(), vertexCount, 2, vertices + offset, stride);
+            offset += 2 * sizeof(HalfFloat);
+        }
+        if (hasNormals)
+            VertexPacking::PackNormals(builder.Normals.data(), vertexCount, 3, vertices + offset, stride);
+        unsigned char* indices = data.m_Storage.data() + placement.IndexOffset;
+        if (placement.IndexType == GL_UNSIGNED_SHORT) {
+            for (size_t i = 0; i < builder.Indices.size(); i++) {
+                const auto index = static_cast<uint16_t>(builder.Indices[i]);
+                std::memcpy(indices + i * sizeof(uint16_t), &index, sizeof(uint16_t));
+            }
+        } else {
+            std::memcpy(indices, builder.Indices.data(), builder.Indices.size() * sizeof(uint32_t));
+        }
+
+        placements.push_back(placement);
+        builder = {};
+    };
+
+    size_t nextGroup = 0;
+    size_t firstCorner = 0;
+    for (size_t face = 0; face < faceSizes.size(); face++) {
+        const unsigned int size = faceSizes[face];
+        while (nextGroup < groupStarts.size() && groupStarts[nextGroup] <= face) {
+            flush();
+            nextGroup++;
+        }
+        if (builder.Vertices.size() + size > MaxChunkVertices)
+            flush();
+
+        unsigned int faceIndices[3];
+        for (unsigned int i = 0; i < size; i++) {
+            const ObjCorner& corner = corners[firstCorner + i];
+            const auto [it, inserted] = builder.Vertices.try_emplace(corner, static_cast<unsigned int>(builder.Vertices.size()));
+            if (inserted) {
+                const glm::vec3& position = positions[corner.Position];
+                builder.Positions.insert(builder.Positions.end(), { position.x, position.y, position.z });
+                if (hasTexCoords) {
+                    const glm::vec2 texCoord = corner.TexCoord >= 0 ? texCoords[corner.TexCoord] : glm::vec2(0.0f);
+                    builder.TexCoords.insert(builder.TexCoords.end(), { texCoord.x, texCoord.y });
+                }
+                if (hasNormals) {
+                    const glm::vec3 normal = corner.Normal >= 0 ? normals[corner.Normal] : glm::vec3(0.0f);
+                    builder.Normals.insert(builder.Normals.end(), { normal.x, normal.y, normal.z });
+                }
+            }
+
+            // Fan around the first corner
+            if (i < 2) {
+                faceIndices[i] = it->second;
+                continue;
+            }
+            faceIndices[2] = it->second;
+            builder.Indices.insert(builder.Indices.end(), { faceIndices[0], faceIndices[1], faceIndices[2] });
+            faceIndices[1] = faceIndices[2];
+        }
+        firstCorner += size;
+    }
+    flush();
+
+    for (const ChunkPlacement& placement : placements) {
+        data.m_Chunks.push_back({ data.m_Storage.data() + placement.VertexOffset, placement.VertexCount,
+                                  data.m_Storage.data() + placement.IndexOffset, placement.IndexCount,
+                                  placement.IndexType, placement.Bounds });
+    }
+    return data;
+}
+
+bool MeshData::Save(const std::string &path) const {
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+        return false;
+
+    const std::vector<VertexBufferElement>& elements = m_Layout.GetElements();
+    MeshFileHeader header{};
+    std::memcpy(header.Magic, s_MeshMagic, sizeof(s_MeshMagic));
+    header.Version = s_MeshVersion;
+    header.ElementCount = static_cast<unsigned int>(elements.size());
+    header.Stride = m_Layout.GetStride();
+    header.ChunkCount = static_cast<unsigned int>(m_Chunks.size());
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const VertexBufferElement& element : elements) {
+        const MeshFileElement entry{ element.type, element.count, element.normalized, element.integer };
+        stream.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+
+    // Blobs follow the tables in chunk order, vertices then indices
+    size_t offset = sizeof(MeshFileHeader) + sizeof(MeshFileElement) * elements.size() + sizeof(MeshFileChunk) * m_Chunks.size();
+    std::vector<size_t> blobOffsets;
+    for (const MeshChunk& chunk : m_Chunks) {
+        MeshFileChunk entry{};
+        entry.VertexOffset = AlignBlob(offset);
+        entry.IndexOffset = AlignBlob(entry.VertexOffset + GetVertexSize(chunk));
+        entry.VertexCount = chunk.VertexCount;
+        entry.IndexCount = chunk.IndexCount;
+        entry.IndexType = chunk.IndexType;
+        std::memcpy(entry.Min, &chunk.Bounds.Min.x, sizeof(entry.Min));
+        std::memcpy(entry.Max, &chunk.Bounds.Max.x, sizeof(entry.Max));
+        stream.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+
+        blobOffsets.push_back(entry.VertexOffset);
+        blobOffsets.push_back(entry.IndexOffset);
+        offset = entry.IndexOffset + GetIndexSize(chunk);
+    }
+
+    static constexpr char padding[s_BlobAlignment] = {};
+    size_t written = sizeof(MeshFileHeader) + sizeof(MeshFileElement) * elements.size() + sizeof(MeshFileChunk) * m_Chunks.size();
+    const auto writeBlob = [&](size_t blobOffset, const void* blob, size_t size) {
+        stream.write(padding, static_cast<std::streamsize>(blobOffset - written));
+        stream.write(static_cast<const char*>(blob), static_cast<std::streamsize>(size));
+        written = blobOffset + size;
+    };
+    for (size_t i = 0; i < m_Chunks.size(); i++) {
+        writeBlob(blobOffsets[i * 2], m_Chunks[i].Vertices, GetVertexSize(m_Chunks[i]));
+        writeBlob(blobOffsets[i * 2 + 1], m_Chunks[i].Indices, GetIndexSize(m_Chunks[i]));
+    }
+
+    return static_cast<bool>(stream);
+}
+
+MeshData MeshData::Load(const std::string &path) {
+    MeshData data;
+    auto file = std::make_unique<MappedFile>(path);
+    if (!file->IsValid() || file->GetSize() < sizeof(MeshFileHeader))
+        return data;
+
+    MeshFileHeader header;
+    std::memcpy(&header, file->GetData(), sizeof(header));
+    if (std::memcmp(header.Magic, s_MeshMagic, sizeof(s_MeshMagic)) != 0 || header.Version != s_MeshVersion)
+        return data;
+    const size_t tablesSize = sizeof(MeshFileHeader) + sizeof(MeshFileElement) * static_cast<size_t>(header.ElementCount)
+                            + sizeof(MeshFileChunk) * static_cast<size_t>(header.ChunkCount);
+    if (header.ElementCount > 16 || file->GetSize() < tablesSize)
+        return data;
+
+    const unsigned char* cursor = file->GetData() + sizeof(MeshFileHeader);
+    for (unsigned int i = 0; i < header.ElementCount; i++, cursor += sizeof(MeshFileElement)) {
+        MeshFileElement entry;
+        std::memcpy(&entry, cursor, sizeof(entry));
+        const VertexBufferElement element{ entry.Type, entry.Count, static_cast<unsigned char>(entry.Normalized),
+                                           0, static_cast<unsigned char>(entry.Integer) };
+        if (entry.Count == 0 || entry.Count > 4 || element.GetSize() == 0)
+            return data;
+        data.m_Layout.Add(element);
+    }
+    if (data.m_Layout.GetStride() != header.Stride)
+        return data;
+
+    const size_t fileSize = file->GetSize();
+    for (unsigned int i = 0; i < header.ChunkCount; i++, cursor += sizeof(MeshFileChunk)) {
+        MeshFileChunk entry;
+        std::memcpy(&entry, cursor, sizeof(entry));
+        if (entry.IndexType != GL_UNSIGNED_SHORT && entry.IndexType != GL_UNSIGNED_INT) {
+            data.m_Chunks.clear();
+            return data;
+        }
+        const size_t indexStride = entry.IndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+        const uint64_t vertexSize = static_cast<uint64_t>(entry.VertexCount) * header.Stride;
+        const uint64_t indexSize = static_cast<uint64_t>(entry.IndexCount) * indexStride;
+        if (entry.VertexOffset > fileSize || vertexSize > fileSize - entry.VertexOffset ||
+            entry.IndexOffset > fileSize || indexSize > fileSize - entry.IndexOffset ||
+            entry.IndexOffset % indexStride != 0 || entry.IndexCount % 3 != 0) {
+            data.m_Chunks.clear();
+            return data;
+        }
+
+        // An index past the chunk's vertices would read outside the buffer on the GPU
+        const unsigned char* indices = file->GetData() + entry.IndexOffset;
+        const unsigned int maxIndex = entry.IndexType == GL_UNSIGNED_SHORT
+            ? MaxIndex(reinterpret_cast<const uint16_t*>(indices), entry.IndexCount)
+            : MaxIndex(reinterpret_cast<const uint32_t*>(indices), entry.IndexCount);
+        if (entry.IndexCount > 0 && maxIndex >= entry.VertexCount) {
+            data.m_Chunks.clear();
+            return data;
+        }
+
+        const AABB bounds{ glm::vec3(entry.Min[0], entry.Min[1], entry.Min[2]), glm::vec3(entry.Max[0], entry.Max[1], entry.Max[2]) };
+        data.m_Chunks.push_back({ file->GetData() + entry.VertexOffset, entry.VertexCount, indices, entry.IndexCount,
+                                  entry.IndexType, bounds });
+    }
+
+    data.m_File = std::move(file);
+    return data;
+}
+
+void MeshData::Prefetch(size_t chunk) const {
+    if (!m_File)
+        return;
+    const MeshChunk& entry = m_Chunks[chunk];
+    m_File->Prefetch(entry.Vertices - m_File->GetData(), GetVertexSize(entry));
+    m_File->Prefetch(static_cast<const unsigned char*>(entry.Indices) - m_File->GetData(), GetIndexSize(entry));
+}
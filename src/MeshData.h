@@ -0,0 +1,67 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Culling.h"
+#include "MappedFile.h"
+#include "VertexBufferLayout.h"
+
+// One piece of a mesh small enough to upload in one go. Indices start at 0
+// for the chunk's first vertex.
+struct MeshChunk {
+    const unsigned char* Vertices;
+    unsigned int VertexCount;
+    const void* Indices;
+    unsigned int IndexCount;
+    unsigned int IndexType; // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    AABB Bounds;
+};
+
+// Interleaved vertex and index data for a mesh, split into chunks and laid
+// out exactly as it is uploaded, with the vertex layout alongside. The bytes
+// are owned either by the object itself or by a memory-mapped mesh file, so
+// loading a converted mesh is a mapping and a few header checks.
+class MeshData {
+public:
+    // Chunks are split so each fits a 16-bit index range, and imported
+    // chunks store and draw their indices as GL_UNSIGNED_SHORT
+    static constexpr unsigned int MaxChunkVertices = 65536;
+private:
+    VertexBufferLayout m_Layout;
+    std::vector<MeshChunk> m_Chunks;
+    std::vector<unsigned char> m_Storage;
+    std::unique_ptr<MappedFile> m_File;
+
+public:
+    // Parses a Wavefront OBJ: positions, texture coordinates and normals, with
+    // polygons fanned into triangles. Every object or group starts a chunk.
+    // Positions stay float; texture coordinates become halves and normals
+    // 2_10_10_10, each only if the file has any. Returns an empty object on failure.
+    static MeshData ImportObj(const std::string& path);
+
+    bool Save(const std::string& path) const;
+    // Maps a file written by Save; chunks point straight into the mapping.
+    // Sizes, offsets and index values are checked, which touches every index
+    // page once. Returns an empty object (no chunks) if the file is missing
+    // or invalid.
+    static MeshData Load(const std::string& path);
+
+    // Faults in a chunk of a mapped file ahead of its upload; safe to call
+    // from any thread
+    void Prefetch(size_t chunk) const;
+
+    inline const VertexBufferLayout& GetLayout() const { return m_Layout; }
+    inline const std::vector<MeshChunk>& GetChunks() const { return m_Chunks; }
+    inline bool IsValid() const { return !m_Chunks.empty(); }
+    inline unsigned int GetVertexSize(const MeshChunk& chunk) const { return chunk.VertexCount * m_Layout.GetStride(); }
+    static inline unsigned int GetIndexSize(const MeshChunk& chunk) {
+        return chunk.IndexCount * (chunk.IndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t));
+    }
+};
@@ -0,0 +1,155 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "MeshLoader.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "Profiler.h"
+
+MeshLoader::MeshLoader(size_t readyByteLimit)
+    : m_ReadyByteLimit(readyByteLimit) {
+    m_Worker = std::thread(&MeshLoader::WorkerLoop, this);
+}
+
+MeshLoader::~MeshLoader() {
+    {
+        std::scoped_lock lock(m_RequestMutex, m_ReadyMutex);
+        m_Stopping = true;
+    }
+    m_RequestAvailable.notify_all();
+    m_ReadySpace.notify_all();
+    m_Worker.join();
+}
+
+std::shared_ptr<Mesh> MeshLoader::Load(const std::string &path) {
+    std::weak_ptr<Mesh>& loaded = m_Loaded[path];
+    if (std::shared_ptr<Mesh> existing = loaded.lock())
+        return existing;
+
+    // Not loaded until the file says how many chunks it has
+    auto mesh = std::make_shared<Mesh>(1);
+    loaded = mesh;
+    {
+        std::lock_guard<std::mutex> lock(m_RequestMutex);
+        m_Requests.push_back({ mesh, path });
+        m_InFlight++;
+    }
+    m_RequestAvailable.notify_one();
+    return mesh;
+}
+
+void MeshLoader::WorkerLoop() {
+    Profiler::SetThreadName("MeshLoader");
+
+    while (true) {
+        LoadRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_RequestMutex);
+            m_RequestAvailable.wait(lock, [this] { return m_Stopping || !m_Requests.empty(); });
+            if (m_Stopping)
+                return;
+            request = std::move(m_Requests.front());
+            m_Requests.pop_front();
+        }
+
+        std::shared_ptr<const MeshData> data;
+        {
+            PROFILE_SCOPE("MeshLoader::Map");
+            auto loaded = std::make_shared<MeshData>(MeshData::Load(request.Path));
+            if (loaded->IsValid())
+                data = std::move(loaded);
+        }
+        if (!data) {
+            PushReady({ std::move(request.Target), nullptr, 0, std::move(request.Path) }, 0);
+            continue;
+        }
+
+        for (size_t i = 0; i < data->GetChunks().size(); i++) {
+            const MeshChunk& chunk = data->GetChunks()[i];
+            {
+                PROFILE_SCOPE("MeshLoader::Prefetch");
+                data->Prefetch(i);
+            }
+            PushReady({ request.Target, data, i, {} }, data->GetVertexSize(chunk) + MeshData::GetIndexSize(chunk));
+        }
+    }
+}
+
+void MeshLoader::PushReady(ReadyChunk chunk, size_t size) {
+    std::unique_lock<std::mutex> lock(m_ReadyMutex);
+    m_ReadySpace.wait(lock, [&] { return m_Stopping || m_ReadyBytes == 0 || m_ReadyBytes + size <= m_ReadyByteLimit; });
+    m_ReadyBytes += size;
+    m_Ready.push_back(std::move(chunk));
+}
+
+void MeshLoader::ProcessUploads(double budgetMilliseconds, unsigned int budgetBytes) {
+    PROFILE_GPU_SCOPE("MeshLoader::ProcessUploads");
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    size_t bytes = 0;
+
+    while (true) {
+        ReadyChunk ready;
+        {
+            std::lock_guard<std::mutex> lock(m_ReadyMutex);
+            if (m_Ready.empty())
+                break;
+            ready = std::move(m_Ready.front());
+            m_Ready.pop_front();
+        }
+
+        size_t size = 0;
+        bool finished = true;
+        if (!ready.Data) {
+            std::cout << "Failed to load mesh '" << ready.Path << "'" << std::endl;
+            ready.Target->SetExpectedChunks(0);
+        } else {
+            const MeshChunk& chunk = ready.Data->GetChunks()[ready.Chunk];
+            size = ready.Data->GetVertexSize(chunk) + MeshData::GetIndexSize(chunk);
+            ready.Target->SetExpectedChunks(static_cast<unsigned int>(ready.Data->GetChunks().size()));
+            ready.Target->AddChunk(ready.Data->GetLayout(), chunk);
+            finished = ready.Chunk + 1 == ready.Data->GetChunks().size();
+
+            m_Stats.Chunks++;
+            m_Stats.UploadedBytes += size;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_ReadyMutex);
+            m_ReadyBytes -= size;
+        }
+        m_ReadySpace.notify_one();
+        if (finished) {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            m_InFlight--;
+        }
+
+        bytes += size;
+        const double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (elapsed >= budgetMilliseconds || bytes >= budgetBytes)
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(m_RequestMutex);
+    m_Stats.Pending = m_InFlight;
+}
+
+void MeshLoader::Finish() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            if (m_InFlight == 0)
+                break;
+        }
+        ProcessUploads(1000.0, ~0u);
+        std::this_thread::yield();
+    }
+}
+
+void MeshLoader::ResetStats() {
+    m_Stats.Chunks = 0;
+    m_Stats.UploadedBytes = 0;
+}
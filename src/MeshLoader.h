@@ -0,0 +1,86 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "Mesh.h"
+#include "MeshData.h"
+#include "StringHash.h"
+
+// Streams converted mesh files in the background. A worker thread maps each
+// file and faults in its chunks one by one; the render thread uploads the
+// ready chunks a few at a time, straight from the mapping. Load returns
+// straight away with a mesh that draws whatever chunks have arrived.
+class MeshLoader {
+public:
+    struct Stats {
+        unsigned int Chunks = 0;
+        uint64_t UploadedBytes = 0;
+        unsigned int Pending = 0;
+    };
+
+private:
+    struct LoadRequest {
+        std::shared_ptr<Mesh> Target;
+        std::string Path;
+    };
+
+    // Data is null when the file failed to load
+    struct ReadyChunk {
+        std::shared_ptr<Mesh> Target;
+        std::shared_ptr<const MeshData> Data;
+        size_t Chunk;
+        std::string Path;
+    };
+
+    std::thread m_Worker;
+    std::deque<LoadRequest> m_Requests;
+    std::deque<ReadyChunk> m_Ready;
+    std::mutex m_RequestMutex;
+    std::mutex m_ReadyMutex;
+    std::condition_variable m_RequestAvailable;
+    std::condition_variable m_ReadySpace;
+    bool m_Stopping{};
+    unsigned int m_InFlight{};
+
+    // Bytes faulted in but not yet uploaded; the worker waits while this is
+    // over the limit, so a huge scene doesn't get paged in all at once
+    size_t m_ReadyBytes{};
+    size_t m_ReadyByteLimit;
+
+    std::unordered_map<std::string, std::weak_ptr<Mesh>, StringHash, std::equal_to<>> m_Loaded;
+    Stats m_Stats;
+
+public:
+    explicit MeshLoader(size_t readyByteLimit = 64 * 1024 * 1024);
+    ~MeshLoader();
+
+    MeshLoader(const MeshLoader&) = delete;
+    MeshLoader& operator=(const MeshLoader&) = delete;
+
+    // Loading a path that is still alive returns the mesh already requested
+    std::shared_ptr<Mesh> Load(const std::string& path);
+
+    // Render thread only. Uploads ready chunks until either budget is spent;
+    // at least one chunk goes up per call so large chunks cannot starve.
+    void ProcessUploads(double budgetMilliseconds = 2.0, unsigned int budgetBytes = 16 * 1024 * 1024);
+    // Blocks until every requested mesh is uploaded
+    void Finish();
+
+    inline const Stats& GetStats() const { return m_Stats; }
+    void ResetStats();
+
+private:
+    void WorkerLoop();
+    void PushReady(ReadyChunk chunk, size_t size);
+};
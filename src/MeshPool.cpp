@@ -0,0 +1,244 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "MeshPool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "Profiler.h"
+#include "Shader.h"
+
+FreeListAllocator::FreeListAllocator(unsigned int capacity) {
+    Reset(capacity, 0);
+}
+
+unsigned int FreeListAllocator::Allocate(unsigned int size) {
+    for (size_t i = 0; i < m_FreeBlocks.size(); i++) {
+        Block& block = m_FreeBlocks[i];
+        if (block.Size < size)
+            continue;
+
+        const unsigned int offset = block.Offset;
+        block.Offset += size;
+        block.Size -= size;
+        if (block.Size == 0)
+            m_FreeBlocks.erase(m_FreeBlocks.begin() + static_cast<std::ptrdiff_t>(i));
+        m_Used += size;
+        return offset;
+    }
+    return Invalid;
+}
+
+void FreeListAllocator::Free(unsigned int offset, unsigned int size) {
+    if (size == 0)
+        return;
+    m_Used -= size;
+
+    auto next = std::lower_bound(m_FreeBlocks.begin(), m_FreeBlocks.end(), offset,
+                                 [](const Block& block, unsigned int value) { return block.Offset < value; });
+    const bool joinsPrevious = next != m_FreeBlocks.begin() && (next - 1)->Offset + (next - 1)->Size == offset;
+    const bool joinsNext = next != m_FreeBlocks.end() && offset + size == next->Offset;
+
+    if (joinsPrevious && joinsNext) {
+        (next - 1)->Size += size + next->Size;
+        m_FreeBlocks.erase(next);
+    } else if (joinsPrevious) {
+        (next - 1)->Size += size;
+    } else if (joinsNext) {
+        next->Offset = offset;
+        next->Size += size;
+    } else {
+        m_FreeBlocks.insert(next, { offset, size });
+    }
+}
+
+void FreeListAllocator::Reset(unsigned int capacity, unsigned int used) {
+    m_Capacity = capacity;
+    m_Used = used;
+    m_FreeBlocks.clear();
+    if (used < capacity)
+        m_FreeBlocks.push_back({ used, capacity - used });
+}
+
+unsigned int FreeListAllocator::GetLargestFreeBlock() const {
+    unsigned int largest = 0;
+    for (const Block& block : m_FreeBlocks)
+        largest = std::max(largest, block.Size);
+    return largest;
+}
+
+MeshPool::MeshPool(const VertexBufferLayout &layout, unsigned int vertexCapacity, unsigned int indexCapacity)
+    : m_Layout(layout), m_VertexBuffer(vertexCapacity * layout.GetStride()), m_IndexBuffer(indexCapacity),
+      m_Vertices(vertexCapacity), m_Indices(indexCapacity) {
+    m_VertexArray.AddBuffer(m_VertexBuffer, m_Layout);
+    m_IndexBuffer.Bind();
+}
+
+MeshHandle MeshPool::Add(const void *vertices, unsigned int vertexCount, const unsigned int *indices, unsigned int indexCount) {
+    unsigned int baseVertex = m_Vertices.Allocate(vertexCount);
+    unsigned int firstIndex = m_Indices.Allocate(indexCount);
+    if (baseVertex == FreeListAllocator::Invalid || firstIndex == FreeListAllocator::Invalid) {
+        if (baseVertex != FreeListAllocator::Invalid)
+            m_Vertices.Free(baseVertex, vertexCount);
+        if (firstIndex != FreeListAllocator::Invalid)
+            m_Indices.Free(firstIndex, indexCount);
+
+        // Compacting is enough when the free space is only split up; otherwise grow
+        unsigned int vertexCapacity = m_Vertices.GetCapacity();
+        unsigned int indexCapacity = m_Indices.GetCapacity();
+        if (m_Vertices.GetFree() < vertexCount)
+            vertexCapacity = std::max(vertexCapacity * 2, m_Vertices.GetUsed() + vertexCount);
+        if (m_Indices.GetFree() < indexCount)
+            indexCapacity = std::max(indexCapacity * 2, m_Indices.GetUsed() + indexCount);
+        if (vertexCapacity != m_Vertices.GetCapacity() || indexCapacity != m_Indices.GetCapacity())
+            m_Stats.Grows++;
+        else
+            m_Stats.Defragmentations++;
+        Rebuild(vertexCapacity, indexCapacity);
+
+        baseVertex = m_Vertices.Allocate(vertexCount);
+        firstIndex = m_Indices.Allocate(indexCount);
+    }
+
+    m_VertexBuffer.SetData(vertices, vertexCount * m_Layout.GetStride(), baseVertex * m_Layout.GetStride());
+    m_IndexBuffer.SetData(indices, indexCount, firstIndex);
+    return m_Meshes.Create(MeshRange{ baseVertex, vertexCount, firstIndex, indexCount });
+}
+
+void MeshPool::Remove(MeshHandle mesh) {
+    const MeshRange* range = m_Meshes.Get(mesh);
+    if (!range)
+        return;
+
+    m_Vertices.Free(range->BaseVertex, range->VertexCount);
+    m_Indices.Free(range->FirstIndex, range->IndexCount);
+    m_Meshes.Destroy(mesh);
+}
+
+void MeshPool::Draw(MeshHandle mesh, const Shader &shader) {
+    const MeshRange* range = m_Meshes.Get(mesh);
+    if (!range)
+        return;
+
+    PROFILE_GPU_SCOPE("MeshPool::Draw");
+    shader.Bind();
+    m_VertexArray.Bind();
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, range->IndexCount, GL_UNSIGNED_INT,
+                                    reinterpret_cast<const void*>(range->FirstIndex * sizeof(unsigned int)), range->BaseVertex));
+    m_Stats.DrawCalls++;
+    m_Stats.Meshes++;
+}
+
+void MeshPool::DrawMulti(const MeshHandle *meshes, size_t count, const Shader &shader) {
+    PROFILE_GPU_SCOPE("MeshPool::DrawMulti");
+
+    m_Counts.clear();
+    m_Offsets.clear();
+    m_BaseVertices.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (const MeshRange* range = m_Meshes.Get(meshes[i])) {
+            m_Counts.push_back(static_cast<int>(range->IndexCount));
+            m_Offsets.push_back(reinterpret_cast<const void*>(range->FirstIndex * sizeof(unsigned int)));
+            m_BaseVertices.push_back(static_cast<int>(range->BaseVertex));
+        }
+    }
+    if (m_Counts.empty())
+        return;
+
+    shader.Bind();
+    m_VertexArray.Bind();
+    GLCall(glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_Counts.data(), GL_UNSIGNED_INT, m_Offsets.data(),
+                                         static_cast<int>(m_Counts.size()), m_BaseVertices.data()));
+    m_Stats.DrawCalls++;
+    m_Stats.Meshes += static_cast<unsigned int>(m_Counts.size());
+}
+
+void MeshPool::Defragment() {
+    if (m_Vertices.GetLargestFreeBlock() == m_Vertices.GetFree() && m_Indices.GetLargestFreeBlock() == m_Indices.GetFree())
+        return;
+    m_Stats.Defragmentations++;
+    Rebuild(m_Vertices.GetCapacity(), m_Indices.GetCapacity());
+}
+
+float MeshPool::GetFragmentation() const {
+    const unsigned int free = m_Vertices.GetFree();
+    return free == 0 ? 0.0f : 1.0f - static_cast<float>(m_Vertices.GetLargestFreeBlock()) / static_cast<float>(free);
+}
+
+// Copies runs of source ranges that stay contiguous in one call
+struct CopyBatcher {
+    unsigned int Source = 0;
+    unsigned int Destination = 0;
+    unsigned int Size = 0;
+
+    void Add(unsigned int source, unsigned int destination, unsigned int size) {
+        if (Size > 0 && Source + Size == source && Destination + Size == destination) {
+            Size += size;
+            return;
+        }
+        Flush();
+        Source = source;
+        Destination = destination;
+        Size = size;
+    }
+
+    void Flush() {
+        if (Size > 0) {
+            GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, Source, Destination, Size));
+        }
+        Size = 0;
+    }
+};
+
+// Packs the live meshes into new buffers on the GPU. Meshes keep their order,
+// so neighbours that were already packed move with a single copy.
+void MeshPool::Rebuild(unsigned int vertexCapacity, unsigned int indexCapacity) {
+    PROFILE_GPU_SCOPE("MeshPool::Rebuild");
+
+    std::vector<MeshRange*> ranges;
+    m_Meshes.ForEach([&](MeshHandle, MeshRange& range) { ranges.push_back(&range); });
+    std::sort(ranges.begin(), ranges.end(), [](const MeshRange* a, const MeshRange* b) { return a->BaseVertex < b->BaseVertex; });
+
+    const unsigned int stride = m_Layout.GetStride();
+    VertexArray vertexArray;
+    VertexBuffer vertexBuffer(vertexCapacity * stride);
+    IndexBuffer indexBuffer(indexCapacity);
+
+    unsigned int vertexCursor = 0;
+    CopyBatcher vertexCopies;
+    GLStateCache::BindBuffer(GL_COPY_READ_BUFFER, m_VertexBuffer.GetRendererID());
+    GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer.GetRendererID());
+    for (MeshRange* range : ranges) {
+        vertexCopies.Add(range->BaseVertex * stride, vertexCursor * stride, range->VertexCount * stride);
+        range->BaseVertex = vertexCursor;
+        vertexCursor += range->VertexCount;
+    }
+    vertexCopies.Flush();
+
+    std::sort(ranges.begin(), ranges.end(), [](const MeshRange* a, const MeshRange* b) { return a->FirstIndex < b->FirstIndex; });
+    unsigned int indexCursor = 0;
+    CopyBatcher indexCopies;
+    GLStateCache::BindBuffer(GL_COPY_READ_BUFFER, m_IndexBuffer.GetRendererID());
+    GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer.GetRendererID());
+    for (MeshRange* range : ranges) {
+        const unsigned int indexSize = sizeof(unsigned int);
+        indexCopies.Add(range->FirstIndex * indexSize, indexCursor * indexSize, range->IndexCount * indexSize);
+        range->FirstIndex = indexCursor;
+        indexCursor += range->IndexCount;
+    }
+    indexCopies.Flush();
+
+    vertexArray.AddBuffer(vertexBuffer, m_Layout);
+    indexBuffer.Bind();
+
+    // The old objects go through the deferred deletion of GLObjectPool
+    m_VertexArray = std::move(vertexArray);
+    m_VertexBuffer = std::move(vertexBuffer);
+    m_IndexBuffer = std::move(indexBuffer);
+    m_Vertices.Reset(vertexCapacity, vertexCursor);
+    m_Indices.Reset(indexCapacity, indexCursor);
+}
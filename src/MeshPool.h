@@ -0,0 +1,119 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "IndexBuffer.h"
+#include "ResourcePool.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+class Shader;
+
+// Where a mesh lives inside the pool's buffers, in vertices and indices.
+// Indices are stored relative to the mesh, BaseVertex is added at draw time.
+struct MeshRange {
+    unsigned int BaseVertex;
+    unsigned int VertexCount;
+    unsigned int FirstIndex;
+    unsigned int IndexCount;
+};
+
+using MeshHandle = ResourceHandle<MeshRange>;
+
+// First-fit allocator over [0, capacity). Free blocks are kept sorted by
+// offset and merged with their neighbours when a range is returned.
+class FreeListAllocator {
+public:
+    static constexpr unsigned int Invalid = ~0u;
+private:
+    struct Block {
+        unsigned int Offset;
+        unsigned int Size;
+    };
+
+    std::vector<Block> m_FreeBlocks;
+    unsigned int m_Capacity = 0;
+    unsigned int m_Used = 0;
+public:
+    explicit FreeListAllocator(unsigned int capacity = 0);
+
+    // Returns Invalid when no free block is large enough
+    unsigned int Allocate(unsigned int size);
+    void Free(unsigned int offset, unsigned int size);
+    // The first used elements are allocated, the rest is one free block
+    void Reset(unsigned int capacity, unsigned int used);
+
+    unsigned int GetLargestFreeBlock() const;
+    inline unsigned int GetCapacity() const { return m_Capacity; }
+    inline unsigned int GetUsed() const { return m_Used; }
+    inline unsigned int GetFree() const { return m_Capacity - m_Used; }
+};
+
+// Static meshes sharing one layout, suballocated from a single vertex buffer
+// and index buffer behind one vertex array. Switching meshes costs no binds,
+// and DrawMulti sends any number of them in one call. When an allocation
+// doesn't fit, the pool first compacts its live meshes and then grows, both
+// by copying on the GPU into new buffers.
+//
+// GL 3.3 has no per-draw index, so meshes drawn together share the shader's
+// uniforms; bake static geometry into world space or use one Draw per mesh.
+class MeshPool {
+public:
+    struct Stats {
+        unsigned int DrawCalls = 0;
+        unsigned int Meshes = 0;
+        unsigned int Defragmentations = 0;
+        unsigned int Grows = 0;
+    };
+private:
+    VertexBufferLayout m_Layout;
+    VertexArray m_VertexArray;
+    VertexBuffer m_VertexBuffer;
+    IndexBuffer m_IndexBuffer;
+    FreeListAllocator m_Vertices;
+    FreeListAllocator m_Indices;
+    ResourcePool<MeshRange> m_Meshes;
+    Stats m_Stats;
+
+    // Scratch for DrawMulti
+    std::vector<int> m_Counts;
+    std::vector<const void*> m_Offsets;
+    std::vector<int> m_BaseVertices;
+public:
+    MeshPool(const VertexBufferLayout& layout, unsigned int vertexCapacity = 65536, unsigned int indexCapacity = 196608);
+
+    MeshPool(const MeshPool&) = delete;
+    MeshPool& operator=(const MeshPool&) = delete;
+
+    // vertices holds vertexCount vertices in the pool's layout
+    MeshHandle Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
+    void Remove(MeshHandle mesh);
+    // nullptr for removed meshes
+    inline const MeshRange* Get(MeshHandle mesh) const { return m_Meshes.Get(mesh); }
+
+    void Draw(MeshHandle mesh, const Shader& shader);
+    void DrawMulti(const MeshHandle* meshes, size_t count, const Shader& shader);
+
+    // Packs every live mesh to the front of the buffers
+    void Defragment();
+    // 0 when the free vertex space is one block, approaching 1 as it splinters
+    float GetFragmentation() const;
+
+    // The buffers are replaced when the pool compacts or grows
+    inline const VertexArray& GetVertexArray() const { return m_VertexArray; }
+    inline const VertexBuffer& GetVertexBuffer() const { return m_VertexBuffer; }
+    inline const IndexBuffer& GetIndexBuffer() const { return m_IndexBuffer; }
+    inline const VertexBufferLayout& GetLayout() const { return m_Layout; }
+    inline size_t GetMeshCount() const { return m_Meshes.GetCount(); }
+    inline const Stats& GetStats() const { return m_Stats; }
+    // Defragmentations and Grows are running totals and survive a reset
+    inline void ResetStats() { m_Stats.DrawCalls = 0; m_Stats.Meshes = 0; }
+
+private:
+    void Rebuild(unsigned int vertexCapacity, unsigned int indexCapacity);
+};
@@ -0,0 +1,56 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "ParticleRenderer.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+#include "Renderer.h"
+
+static constexpr float s_QuadCorners[] = {
+    -0.5f, -0.5f,
+     0.5f, -0.5f,
+     0.5f,  0.5f,
+    -0.5f,  0.5f
+};
+
+static constexpr unsigned int s_QuadIndices[] = { 0, 1, 2, 2, 3, 0 };
+
+ParticleRenderer::ParticleRenderer(unsigned int maxParticles, const std::string &shaderPath)
+    : m_MaxParticles(maxParticles),
+      m_QuadBuffer(s_QuadCorners, sizeof(s_QuadCorners)),
+      m_IndexBuffer(s_QuadIndices, 6),
+      m_InstanceBuffer(std::max(maxParticles, 1u) * static_cast<unsigned int>(sizeof(ParticleVertex))),
+      m_Shader(shaderPath) {
+    static_assert(sizeof(ParticleVertex) == 20, "ParticleVertex must match the instance layout");
+
+    VertexBufferLayout quadLayout;
+    quadLayout.Push<float>(2);
+    m_VertexArray.AddBuffer(m_QuadBuffer, quadLayout);
+
+    m_InstanceLayout.Push<float>(3, 1);         // position
+    m_InstanceLayout.Push<float>(1, 1);         // size
+    m_InstanceLayout.Push<unsigned char>(4, 1); // color
+    m_FirstInstanceAttrib = m_VertexArray.GetAttribCount();
+    m_VertexArray.AddBuffer(m_InstanceBuffer, m_InstanceLayout);
+}
+
+void ParticleRenderer::Draw(const Renderer &renderer, const ParticleSystem &particles, JobSystem *jobs) {
+    const auto count = static_cast<unsigned int>(std::min<size_t>(particles.GetCount(), m_MaxParticles));
+    if (count == 0)
+        return;
+
+    PROFILE_GPU_SCOPE("ParticleRenderer::Draw");
+    unsigned int offset;
+    void* data = m_InstanceBuffer.Allocate(count * sizeof(ParticleVertex), sizeof(ParticleVertex), offset);
+    particles.WriteVertices(static_cast<ParticleVertex*>(data), count, jobs);
+    m_InstanceBuffer.Commit();
+
+    // GL 3.3 has no base instance, so the instance attributes are moved to
+    // where this frame's data landed instead
+    m_VertexArray.SetBufferOffset(m_InstanceBuffer, m_InstanceLayout, m_FirstInstanceAttrib, offset);
+    renderer.DrawInstanced(m_VertexArray, m_IndexBuffer, m_Shader, count);
+    m_InstanceBuffer.EndFrame();
+}
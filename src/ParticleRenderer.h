@@ -0,0 +1,43 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <string>
+
+#include "DynamicVertexBuffer.h"
+#include "IndexBuffer.h"
+#include "ParticleSystem.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+class JobSystem;
+class Renderer;
+
+// Draws a ParticleSystem as one instanced draw of a camera-facing quad. The
+// particles are written straight into a streamed instance buffer (mapped GPU
+// memory where persistent mapping is available), so there is no staging copy.
+class ParticleRenderer {
+private:
+    unsigned int m_MaxParticles;
+    VertexBuffer m_QuadBuffer;
+    IndexBuffer m_IndexBuffer;
+    DynamicVertexBuffer m_InstanceBuffer;
+    VertexArray m_VertexArray;
+    VertexBufferLayout m_InstanceLayout;
+    unsigned int m_FirstInstanceAttrib{};
+    Shader m_Shader;
+
+public:
+    // Particles past maxParticles are not drawn
+    explicit ParticleRenderer(unsigned int maxParticles, const std::string& shaderPath = "res/shaders/Particle.shader");
+
+    // Fills this frame's region of the instance buffer, with jobs splitting the
+    // writes across threads, and draws. Each call uses a region of its own.
+    void Draw(const Renderer& renderer, const ParticleSystem& particles, JobSystem* jobs = nullptr);
+
+    inline const DynamicVertexBuffer& GetInstanceBuffer() const { return m_InstanceBuffer; }
+};
@@ -0,0 +1,258 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PARTICLES_SSE2 1
+#else
+    #define PARTICLES_SSE2 0
+#endif
+
+// Eight-wide integration when the build targets AVX (-mavx or -march with it)
+#if PARTICLES_SSE2 && defined(__AVX__)
+    #include <immintrin.h>
+    #define PARTICLES_AVX 1
+#else
+    #define PARTICLES_AVX 0
+#endif
+
+// Streams are padded to this many floats
+static constexpr size_t s_VectorWidth = 8;
+
+static inline size_t RoundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// Channels already scaled to [0, 255]; rounds to nearest even, like _mm_cvtps_epi32
+static inline uint32_t PackColor(const glm::vec4& color) {
+    const glm::vec4 scaled = glm::clamp(color, 0.0f, 255.0f);
+    return static_cast<uint32_t>(std::lrint(scaled.r)) | static_cast<uint32_t>(std::lrint(scaled.g)) << 8 |
+           static_cast<uint32_t>(std::lrint(scaled.b)) << 16 | static_cast<uint32_t>(std::lrint(scaled.a)) << 24;
+}
+
+ParticleSystem::ParticleSystem(size_t capacity)
+    : m_Capacity(capacity) {
+    const size_t padded = RoundUp(std::max<size_t>(capacity, 1), s_VectorWidth);
+    m_Storage.assign(padded * StreamCount, 0.0f);
+    for (size_t i = 0; i < StreamCount; i++)
+        m_Streams[i] = m_Storage.data() + i * padded;
+}
+
+float ParticleSystem::NextRandom() {
+    // xorshift32, mapped to [-1, 1)
+    m_Random ^= m_Random << 13;
+    m_Random ^= m_Random >> 17;
+    m_Random ^= m_Random << 5;
+    return static_cast<float>(m_Random >> 8) * (1.0f / 8388608.0f) - 1.0f;
+}
+
+size_t ParticleSystem::Emit(const ParticleEmitDescription &description, size_t count) {
+    const size_t emitted = std::min(count, m_Capacity - m_Count);
+    m_Stats.Emitted += static_cast<unsigned int>(emitted);
+    m_Stats.Dropped += static_cast<unsigned int>(count - emitted);
+
+    for (size_t n = 0; n < emitted; n++) {
+        const size_t i = m_Count++;
+        m_Streams[PositionX][i] = description.Position.x + description.PositionSpread.x * NextRandom();
+        m_Streams[PositionY][i] = description.Position.y + description.PositionSpread.y * NextRandom();
+        m_Streams[PositionZ][i] = description.Position.z + description.PositionSpread.z * NextRandom();
+        m_Streams[VelocityX][i] = description.Velocity.x + description.VelocitySpread.x * NextRandom();
+        m_Streams[VelocityY][i] = description.Velocity.y + description.VelocitySpread.y * NextRandom();
+        m_Streams[VelocityZ][i] = description.Velocity.z + description.VelocitySpread.z * NextRandom();
+        const float lifetime = std::max(description.Lifetime + description.LifetimeSpread * NextRandom(), 1.0e-4f);
+        m_Streams[Life][i] = 0.0f;
+        m_Streams[LifeRate][i] = 1.0f / lifetime;
+    }
+    return emitted;
+}
+
+void ParticleSystem::Update(float deltaTime, JobSystem *jobs) {
+    PROFILE_SCOPE("ParticleSystem::Update");
+    if (jobs) {
+        jobs->ParallelFor(m_Count, BatchSize, [this, deltaTime](size_t begin, size_t end) {
+            Integrate(begin, end, deltaTime);
+        });
+    } else {
+        Integrate(0, m_Count, deltaTime);
+    }
+    Compact();
+}
+
+// begin is a multiple of the vector width; end is rounded up into the padding,
+// which holds stale particles whose results are never read
+void ParticleSystem::Integrate(size_t begin, size_t end, float deltaTime) {
+    float* const px = m_Streams[PositionX];
+    float* const py = m_Streams[PositionY];
+    float* const pz = m_Streams[PositionZ];
+    float* const vx = m_Streams[VelocityX];
+    float* const vy = m_Streams[VelocityY];
+    float* const vz = m_Streams[VelocityZ];
+    float* const life = m_Streams[Life];
+    const float* const rate = m_Streams[LifeRate];
+    const float damping = std::max(0.0f, 1.0f - m_Drag * deltaTime);
+    const glm::vec3 impulse = m_Gravity * deltaTime;
+
+#if PARTICLES_AVX
+    end = RoundUp(end, 8);
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 damp = _mm256_set1_ps(damping);
+    const __m256 gx = _mm256_set1_ps(impulse.x), gy = _mm256_set1_ps(impulse.y), gz = _mm256_set1_ps(impulse.z);
+    for (size_t i = begin; i < end; i += 8) {
+        const __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vx + i), damp), gx);
+        const __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vy + i), damp), gy);
+        const __m256 z = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vz + i), damp), gz);
+        _mm256_storeu_ps(vx + i, x);
+        _mm256_storeu_ps(vy + i, y);
+        _mm256_storeu_ps(vz + i, z);
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(x, dt)));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(y, dt)));
+        _mm256_storeu_ps(pz + i, _mm256_add_ps(_mm256_loadu_ps(pz + i), _mm256_mul_ps(z, dt)));
+        _mm256_storeu_ps(life + i, _mm256_add_ps(_mm256_loadu_ps(life + i), _mm256_mul_ps(_mm256_loadu_ps(rate + i), dt)));
+    }
+#elif PARTICLES_SSE2
+    end = RoundUp(end, 4);
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 damp = _mm_set1_ps(damping);
+    const __m128 gx = _mm_set1_ps(impulse.x), gy = _mm_set1_ps(impulse.y), gz = _mm_set1_ps(impulse.z);
+    for (size_t i = begin; i < end; i += 4) {
+        const __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), damp), gx);
+        const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damp), gy);
+        const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vz + i), damp), gz);
+        _mm_storeu_ps(vx + i, x);
+        _mm_storeu_ps(vy + i, y);
+        _mm_storeu_ps(vz + i, z);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(x, dt)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(y, dt)));
+        _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(z, dt)));
+        _mm_storeu_ps(life + i, _mm_add_ps(_mm_loadu_ps(life + i), _mm_mul_ps(_mm_loadu_ps(rate + i), dt)));
+    }
+#else
+    for (size_t i = begin; i < end; i++) {
+        vx[i] = vx[i] * damping + impulse.x;
+        vy[i] = vy[i] * damping + impulse.y;
+        vz[i] = vz[i] * damping + impulse.z;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        pz[i] += vz[i] * deltaTime;
+        life[i] += rate[i] * deltaTime;
+    }
+#endif
+}
+
+// A particle dies when its normalized life reaches 1. Runs of four live
+// particles are skipped with one compare; a dead one is overwritten by the
+// last particle, which is checked in turn.
+void ParticleSystem::Compact() {
+    const float* const life = m_Streams[Life];
+#if PARTICLES_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+#endif
+    size_t i = 0;
+    while (i < m_Count) {
+#if PARTICLES_SSE2
+        if (i + 4 <= m_Count && _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(life + i), one)) == 0) {
+            i += 4;
+            continue;
+        }
+#endif
+        if (life[i] < 1.0f) {
+            i++;
+            continue;
+        }
+
+        const size_t last = --m_Count;
+        for (float* stream : m_Streams)
+            stream[i] = stream[last];
+        m_Stats.Killed++;
+    }
+}
+
+void ParticleSystem::WriteVertices(ParticleVertex *destination, size_t count, JobSystem *jobs) const {
+    PROFILE_SCOPE("ParticleSystem::WriteVertices");
+    count = std::min(count, m_Count);
+    if (jobs) {
+        jobs->ParallelFor(count, BatchSize, [this, destination](size_t begin, size_t end) {
+            Write(destination, begin, end);
+        });
+    } else {
+        Write(destination, 0, count);
+    }
+}
+
+void ParticleSystem::Write(ParticleVertex *destination, size_t begin, size_t end) const {
+    const float* const px = m_Streams[PositionX];
+    const float* const py = m_Streams[PositionY];
+    const float* const pz = m_Streams[PositionZ];
+    const float* const life = m_Streams[Life];
+    // Colors are ramped in [0, 255] so the scalar tail matches the SIMD lanes
+    const glm::vec4 startColor = m_Ramp.StartColor * 255.0f;
+    const glm::vec4 colorRange = (m_Ramp.EndColor - m_Ramp.StartColor) * 255.0f;
+    const float sizeRange = m_Ramp.EndSize - m_Ramp.StartSize;
+
+    size_t i = begin;
+#if PARTICLES_SSE2
+    // Ramps are evaluated four particles at a time, then the streams are
+    // transposed into position/size rows and stored as whole vertices
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 startSize = _mm_set1_ps(m_Ramp.StartSize), sizeStep = _mm_set1_ps(sizeRange);
+    __m128 startChannel[4], channelStep[4];
+    for (int c = 0; c < 4; c++) {
+        startChannel[c] = _mm_set1_ps(startColor[c]);
+        channelStep[c] = _mm_set1_ps(colorRange[c]);
+    }
+
+    for (; i + 4 <= end; i += 4) {
+        const __m128 t = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(life + i), zero), one);
+
+        __m128i color = _mm_setzero_si128();
+        for (int c = 0; c < 4; c++) {
+            const __m128 channel = _mm_min_ps(_mm_max_ps(_mm_add_ps(startChannel[c], _mm_mul_ps(channelStep[c], t)), zero), scale);
+            color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(channel), c * 8));
+        }
+        alignas(16) uint32_t colors[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(colors), color);
+
+        __m128 x = _mm_loadu_ps(px + i);
+        __m128 y = _mm_loadu_ps(py + i);
+        __m128 z = _mm_loadu_ps(pz + i);
+        __m128 size = _mm_add_ps(startSize, _mm_mul_ps(sizeStep, t));
+        _MM_TRANSPOSE4_PS(x, y, z, size);
+
+        ParticleVertex* out = destination + i;
+        _mm_storeu_ps(&out[0].Position.x, x);
+        out[0].Color = colors[0];
+        _mm_storeu_ps(&out[1].Position.x, y);
+        out[1].Color = colors[1];
+        _mm_storeu_ps(&out[2].Position.x, z);
+        out[2].Color = colors[2];
+        _mm_storeu_ps(&out[3].Position.x, size);
+        out[3].Color = colors[3];
+    }
+#endif
+    for (; i < end; i++) {
+        const float t = std::clamp(life[i], 0.0f, 1.0f);
+        ParticleVertex& out = destination[i];
+        out.Position = glm::vec3(px[i], py[i], pz[i]);
+        out.Size = m_Ramp.StartSize + sizeRange * t;
+        out.Color = PackColor(startColor + colorRange * t);
+    }
+}
+
+void ParticleSystem::Clear() {
+    m_Count = 0;
+}
+
+void ParticleSystem::ResetStats() {
+    m_Stats = {};
+}
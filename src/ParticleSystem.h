@@ -0,0 +1,103 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class JobSystem;
+
+// One particle as the GPU sees it, drawn as an instance of a camera-facing quad
+struct ParticleVertex {
+    glm::vec3 Position;
+    float Size;
+    uint32_t Color; // RGBA8, red in the low byte
+};
+
+struct ParticleEmitDescription {
+    glm::vec3 Position{ 0.0f };
+    // Each axis is offset by up to +-spread
+    glm::vec3 PositionSpread{ 0.0f };
+    glm::vec3 Velocity{ 0.0f };
+    glm::vec3 VelocitySpread{ 0.0f };
+    float Lifetime = 1.0f;
+    float LifetimeSpread = 0.0f;
+};
+
+// Color and size are interpolated from start to end over each particle's life
+struct ParticleRamp {
+    glm::vec4 StartColor{ 1.0f };
+    glm::vec4 EndColor{ 1.0f, 1.0f, 1.0f, 0.0f };
+    float StartSize = 1.0f;
+    float EndSize = 1.0f;
+};
+
+// CPU particle simulation stored as structure-of-arrays, one float stream per
+// component, so the update runs 8 (AVX) or 4 (SSE) particles per instruction.
+// Everything is allocated up front: emitting past the capacity drops
+// particles, and dead ones are removed by moving the last live particle into
+// their slot, so live particles always fill [0, count).
+class ParticleSystem {
+public:
+    // Particles per job when an update is split across threads
+    static constexpr size_t BatchSize = 16384;
+
+    struct Stats {
+        unsigned int Emitted = 0;
+        unsigned int Dropped = 0;
+        unsigned int Killed = 0;
+    };
+
+private:
+    enum Stream { PositionX, PositionY, PositionZ, VelocityX, VelocityY, VelocityZ, Life, LifeRate, StreamCount };
+
+    // Streams are padded to a whole number of vectors, so kernels never need a scalar tail
+    std::vector<float> m_Storage;
+    float* m_Streams[StreamCount]{};
+    size_t m_Capacity;
+    size_t m_Count{};
+
+    glm::vec3 m_Gravity{ 0.0f };
+    float m_Drag{};
+    ParticleRamp m_Ramp;
+    uint32_t m_Random = 0x9E3779B9u;
+    Stats m_Stats;
+
+public:
+    explicit ParticleSystem(size_t capacity);
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // Returns how many fit
+    size_t Emit(const ParticleEmitDescription& description, size_t count);
+
+    // Integrates and ages every particle, then removes the dead ones. With
+    // jobs the integration is split across its threads; compaction is serial.
+    void Update(float deltaTime, JobSystem* jobs = nullptr);
+    // Writes the first count live particles (all by default) with their
+    // color and size ramps applied. destination may be mapped GPU memory: it
+    // is written once, front to back, and never read.
+    void WriteVertices(ParticleVertex* destination, size_t count = SIZE_MAX, JobSystem* jobs = nullptr) const;
+
+    void Clear();
+
+    inline void SetGravity(const glm::vec3& gravity) { m_Gravity = gravity; }
+    // Fraction of velocity lost per second
+    inline void SetDrag(float drag) { m_Drag = drag; }
+    inline void SetRamp(const ParticleRamp& ramp) { m_Ramp = ramp; }
+
+    inline size_t GetCount() const { return m_Count; }
+    inline size_t GetCapacity() const { return m_Capacity; }
+    inline const Stats& GetStats() const { return m_Stats; }
+    void ResetStats();
+
+private:
+    void Integrate(size_t begin, size_t end, float deltaTime);
+    void Compact();
+    void Write(ParticleVertex* destination, size_t begin, size_t end) const;
+    float NextRandom();
+};
@@ -0,0 +1,373 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+namespace {
+
+// Single producer (the owning thread), single consumer (EndFrame). A full ring
+// drops events instead of blocking the thread being profiled.
+class ThreadRing {
+public:
+    static constexpr uint32_t Capacity = 8192;
+
+    uint32_t Index;
+    const char* Name = nullptr;
+    std::atomic<uint32_t> Dropped{ 0 };
+
+    explicit ThreadRing(uint32_t index) : Index(index) {}
+
+    void Push(const ProfileEvent& event) {
+        const uint32_t head = m_Head.load(std::memory_order_relaxed);
+        if (head - m_Tail.load(std::memory_order_acquire) == Capacity) {
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_Events[head % Capacity] = event;
+        m_Head.store(head + 1, std::memory_order_release);
+    }
+
+    template<typename F>
+    void Drain(F&& consume) {
+        const uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+        const uint32_t head = m_Head.load(std::memory_order_acquire);
+        for (uint32_t i = tail; i != head; i++)
+            consume(m_Events[i % Capacity]);
+        m_Tail.store(head, std::memory_order_release);
+    }
+
+private:
+    std::array<ProfileEvent, Capacity> m_Events{};
+    alignas(64) std::atomic<uint32_t> m_Head{ 0 };
+    alignas(64) std::atomic<uint32_t> m_Tail{ 0 };
+};
+
+struct GpuScope {
+    const char* Name;
+    uint32_t Depth;
+    unsigned int BeginQuery;
+    unsigned int EndQuery;
+};
+
+// Timestamp queries of one frame; reused GpuFrameLatency frames later
+struct GpuFrame {
+    uint64_t FrameNumber = 0;
+    int64_t ClockOffset = 0;  // CPU time minus GPU time, in nanoseconds
+    std::vector<unsigned int> Queries;
+    unsigned int UsedQueries = 0;
+    std::vector<GpuScope> Scopes;
+};
+
+struct ProfileFrame {
+    uint64_t Number = UINT64_MAX;
+    uint64_t Start = 0;
+    uint64_t End = 0;
+    std::vector<ProfileEvent> Events;
+};
+
+}
+
+static const auto s_Epoch = std::chrono::steady_clock::now();
+
+static std::mutex s_RingMutex;
+static std::vector<std::unique_ptr<ThreadRing>> s_Rings;
+static thread_local ThreadRing* t_Ring = nullptr;
+static thread_local uint32_t t_Depth = 0;
+
+// Everything below is only touched by the thread running frames
+static std::thread::id s_FrameThread;
+static bool s_InFrame = false;
+static uint64_t s_FrameNumber = 0;
+static uint64_t s_FrameStart = 0;
+static ProfileFrame s_History[Profiler::HistorySize];
+static GpuFrame s_GpuFrames[Profiler::GpuFrameLatency];
+static std::vector<unsigned int> s_GpuStack;
+static uint64_t s_DroppedGpuFrames = 0;
+
+static bool s_Paused = false;
+static ProfileFrame s_Displayed;
+
+static ThreadRing& GetThreadRing() {
+    if (!t_Ring) {
+        std::lock_guard<std::mutex> lock(s_RingMutex);
+        s_Rings.push_back(std::make_unique<ThreadRing>(static_cast<uint32_t>(s_Rings.size())));
+        t_Ring = s_Rings.back().get();
+    }
+    return *t_Ring;
+}
+
+static bool IsFrameThread() {
+    return s_InFrame && std::this_thread::get_id() == s_FrameThread;
+}
+
+static unsigned int AllocateQuery(GpuFrame& frame) {
+    if (frame.UsedQueries == frame.Queries.size()) {
+        constexpr unsigned int growth = 64;
+        frame.Queries.resize(frame.Queries.size() + growth);
+        GLCall(glGenQueries(growth, frame.Queries.data() + frame.Queries.size() - growth));
+    }
+    return frame.Queries[frame.UsedQueries++];
+}
+
+// Moves the finished GPU scopes of an old frame into its history entry. If the
+// GPU hasn't caught up yet the frame's results are dropped rather than waited for.
+static void ResolveGpuFrame(GpuFrame& gpu) {
+    if (gpu.Scopes.empty())
+        return;
+
+    int available = GL_FALSE;
+    GLCall(glGetQueryObjectiv(gpu.Queries[gpu.UsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available));
+    ProfileFrame& frame = s_History[gpu.FrameNumber % Profiler::HistorySize];
+    if (available == GL_FALSE || frame.Number != gpu.FrameNumber) {
+        s_DroppedGpuFrames++;
+        return;
+    }
+
+    for (const GpuScope& scope : gpu.Scopes) {
+        if (scope.EndQuery == 0)
+            continue;
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        GLCall(glGetQueryObjectui64v(scope.BeginQuery, GL_QUERY_RESULT, &begin));
+        GLCall(glGetQueryObjectui64v(scope.EndQuery, GL_QUERY_RESULT, &end));
+        frame.Events.push_back({ scope.Name, static_cast<uint64_t>(begin + gpu.ClockOffset),
+                                 static_cast<uint64_t>(end + gpu.ClockOffset), scope.Depth, Profiler::GpuTrack });
+    }
+}
+
+uint64_t Profiler::Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count();
+}
+
+void Profiler::SetThreadName(const char* name) {
+    GetThreadRing().Name = name;
+}
+
+uint32_t Profiler::PushDepth() {
+    return t_Depth++;
+}
+
+void Profiler::PopDepth() {
+    t_Depth--;
+}
+
+void Profiler::RecordCpu(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+    ThreadRing& ring = GetThreadRing();
+    ring.Push({ name, start, end, depth, ring.Index });
+}
+
+void Profiler::BeginFrame() {
+    s_FrameThread = std::this_thread::get_id();
+    s_InFrame = true;
+    s_FrameStart = Now();
+
+    GpuFrame& gpu = s_GpuFrames[s_FrameNumber % GpuFrameLatency];
+    ResolveGpuFrame(gpu);
+    gpu.FrameNumber = s_FrameNumber;
+    gpu.UsedQueries = 0;
+    gpu.Scopes.clear();
+
+    // Queried every frame since the two clocks drift apart
+    GLint64 gpuTime = 0;
+    GLCall(glGetInteger64v(GL_TIMESTAMP, &gpuTime));
+    gpu.ClockOffset = static_cast<int64_t>(Now()) - gpuTime;
+}
+
+void Profiler::EndFrame() {
+    ProfileFrame& frame = s_History[s_FrameNumber % HistorySize];
+    frame.Number = s_FrameNumber;
+    frame.Start = s_FrameStart;
+    frame.End = Now();
+    frame.Events.clear();
+    {
+        std::lock_guard<std::mutex> lock(s_RingMutex);
+        for (const auto& ring : s_Rings)
+            ring->Drain([&](const ProfileEvent& event) { frame.Events.push_back(event); });
+    }
+
+    s_GpuStack.clear();
+    s_InFrame = false;
+    s_FrameNumber++;
+}
+
+void Profiler::BeginGpu(const char* name) {
+    if (!IsFrameThread())
+        return;
+
+    GpuFrame& gpu = s_GpuFrames[s_FrameNumber % GpuFrameLatency];
+    const unsigned int query = AllocateQuery(gpu);
+    GLCall(glQueryCounter(query, GL_TIMESTAMP));
+    s_GpuStack.push_back(static_cast<unsigned int>(gpu.Scopes.size()));
+    gpu.Scopes.push_back({ name, static_cast<uint32_t>(s_GpuStack.size() - 1), query, 0 });
+}
+
+void Profiler::EndGpu() {
+    if (!IsFrameThread() || s_GpuStack.empty())
+        return;
+
+    GpuFrame& gpu = s_GpuFrames[s_FrameNumber % GpuFrameLatency];
+    const unsigned int query = AllocateQuery(gpu);
+    GLCall(glQueryCounter(query, GL_TIMESTAMP));
+    gpu.Scopes[s_GpuStack.back()].EndQuery = query;
+    s_GpuStack.pop_back();
+}
+
+static void WriteJsonString(std::ostream& stream, const char* value) {
+    stream << '"';
+    for (const char* c = value; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            stream << '\\';
+        stream << *c;
+    }
+    stream << '"';
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) {
+    std::ofstream stream(path);
+    if (!stream)
+        return false;
+
+    stream << "{\"traceEvents\":[\n";
+    {
+        std::lock_guard<std::mutex> lock(s_RingMutex);
+        for (const auto& ring : s_Rings) {
+            const std::string name = ring->Name ? ring->Name : "Thread " + std::to_string(ring->Index);
+            stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << ring->Index << ",\"args\":{\"name\":";
+            WriteJsonString(stream, name.c_str());
+            stream << "}},\n";
+        }
+    }
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << GpuTrack << ",\"args\":{\"name\":\"GPU\"}}";
+
+    // Timestamps are in microseconds
+    const uint64_t first = s_FrameNumber > HistorySize ? s_FrameNumber - HistorySize : 0;
+    for (uint64_t number = first; number < s_FrameNumber; number++) {
+        const ProfileFrame& frame = s_History[number % HistorySize];
+        if (frame.Number != number)
+            continue;
+
+        for (const ProfileEvent& event : frame.Events) {
+            stream << ",\n{\"name\":";
+            WriteJsonString(stream, event.Name);
+            stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.Track
+                   << ",\"ts\":" << event.Start / 1000.0 << ",\"dur\":" << (event.End - event.Start) / 1000.0 << "}";
+        }
+    }
+    stream << "\n]}\n";
+    return true;
+}
+
+static ImU32 GetEventColor(const char* name) {
+    // Same name, same color from frame to frame
+    const float hue = static_cast<float>(std::hash<std::string_view>{}(name) % 360) / 360.0f;
+    return ImColor::HSV(hue, 0.5f, 0.65f);
+}
+
+void Profiler::DrawImGui(bool* open) {
+    if (!ImGui::Begin("Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Checkbox("Pause", &s_Paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome trace"))
+        ExportChromeTrace("profile.json");
+
+    float frameTimes[HistorySize] = {};
+    for (unsigned int i = 0; i < HistorySize; i++) {
+        const uint64_t number = s_FrameNumber + i - HistorySize;
+        const ProfileFrame& frame = s_History[number % HistorySize];
+        if (s_FrameNumber + i >= HistorySize && frame.Number == number)
+            frameTimes[i] = (frame.End - frame.Start) / 1.0e6f;
+    }
+    ImGui::PlotLines("##FrameTimes", frameTimes, HistorySize, 0, "CPU frame (ms)", 0.0f, FLT_MAX,
+                     ImVec2(ImGui::GetContentRegionAvailWidth(), 50.0f));
+
+    // The newest frame whose GPU results have been read back
+    if (!s_Paused && s_FrameNumber >= GpuFrameLatency) {
+        const ProfileFrame& frame = s_History[(s_FrameNumber - GpuFrameLatency) % HistorySize];
+        if (frame.Number == s_FrameNumber - GpuFrameLatency)
+            s_Displayed = frame;
+    }
+    if (s_Displayed.Number == UINT64_MAX) {
+        ImGui::End();
+        return;
+    }
+
+    const ProfileFrame& frame = s_Displayed;
+    uint64_t end = frame.End;
+    double gpuMs = 0.0;
+    std::vector<std::pair<uint32_t, uint32_t>> tracks;  // Track, lane count
+    for (const ProfileEvent& event : frame.Events) {
+        end = std::max(end, event.End);
+        if (event.Track == GpuTrack && event.Depth == 0)
+            gpuMs += (event.End - event.Start) / 1.0e6;
+
+        auto it = std::find_if(tracks.begin(), tracks.end(), [&](const auto& track) { return track.first == event.Track; });
+        if (it == tracks.end())
+            tracks.emplace_back(event.Track, event.Depth + 1);
+        else
+            it->second = std::max(it->second, event.Depth + 1);
+    }
+    // GPU track is GpuTrack, so it sorts last
+    std::sort(tracks.begin(), tracks.end());
+
+    ImGui::Text("Frame %llu  CPU %.3f ms  GPU %.3f ms  (dropped GPU frames: %llu)",
+                static_cast<unsigned long long>(frame.Number), (frame.End - frame.Start) / 1.0e6, gpuMs,
+                static_cast<unsigned long long>(s_DroppedGpuFrames));
+
+    constexpr float laneHeight = 18.0f;
+    constexpr float labelWidth = 90.0f;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = std::max(100.0f, ImGui::GetContentRegionAvailWidth() - labelWidth);
+    const double scale = width / static_cast<double>(std::max<uint64_t>(1, end - frame.Start));
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    float y = origin.y;
+    for (const auto& [track, lanes] : tracks) {
+        std::string label = track == GpuTrack ? "GPU" : "Thread " + std::to_string(track);
+        if (track != GpuTrack) {
+            std::lock_guard<std::mutex> lock(s_RingMutex);
+            if (track < s_Rings.size() && s_Rings[track]->Name)
+                label = s_Rings[track]->Name;
+        }
+        drawList->AddText(ImVec2(origin.x, y), ImGui::GetColorU32(ImGuiCol_Text), label.c_str());
+
+        for (const ProfileEvent& event : frame.Events) {
+            if (event.Track != track || event.End < frame.Start)
+                continue;
+
+            const float x0 = origin.x + labelWidth + static_cast<float>((std::max(event.Start, frame.Start) - frame.Start) * scale);
+            const float x1 = std::max(x0 + 1.0f, origin.x + labelWidth + static_cast<float>((event.End - frame.Start) * scale));
+            const ImVec2 min(x0, y + event.Depth * laneHeight);
+            const ImVec2 max(x1, min.y + laneHeight - 1.0f);
+            drawList->AddRectFilled(min, max, GetEventColor(event.Name));
+            if (ImGui::CalcTextSize(event.Name).x < x1 - x0 - 4.0f)
+                drawList->AddText(ImVec2(x0 + 2.0f, min.y + 1.0f), IM_COL32_WHITE, event.Name);
+            if (ImGui::IsMouseHoveringRect(min, max))
+                ImGui::SetTooltip("%s\n%.3f ms", event.Name, (event.End - event.Start) / 1.0e6);
+        }
+        y += lanes * laneHeight + 4.0f;
+    }
+    ImGui::Dummy(ImVec2(labelWidth + width, y - origin.y));
+
+    ImGui::End();
+}
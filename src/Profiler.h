@@ -0,0 +1,87 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped CPU and GPU markers, selected with the MODERNOPENGL_PROFILING CMake option.
+//   PROFILE_SCOPE("Name")      CPU time of the enclosing scope, on any thread
+//   PROFILE_GPU_SCOPE("Name")  CPU time plus GL_TIMESTAMP queries around the
+//                              scope; only recorded on the thread running frames
+// Names must be string literals (or otherwise outlive the profiler).
+#ifndef PROFILING
+    #define PROFILING 1
+#endif
+
+struct ProfileEvent {
+    const char* Name;
+    uint64_t Start;  // Nanoseconds since the profiler started
+    uint64_t End;
+    uint32_t Depth;
+    uint32_t Track;  // Thread index, or Profiler::GpuTrack
+};
+
+class Profiler {
+public:
+    static constexpr uint32_t GpuTrack = 0xFFFFFFFF;
+    // GPU results are read back this many frames late so the queries never stall
+    static constexpr unsigned int GpuFrameLatency = 2;
+    static constexpr unsigned int HistorySize = 128;
+
+    // Bracket every frame on the thread that owns the GL context
+    static void BeginFrame();
+    static void EndFrame();
+
+    static uint64_t Now();
+    static void SetThreadName(const char* name);
+
+    static uint32_t PushDepth();
+    static void PopDepth();
+    static void RecordCpu(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+    static void BeginGpu(const char* name);
+    static void EndGpu();
+
+    // Writes the frames still in the history as a chrome://tracing / Perfetto file
+    static bool ExportChromeTrace(const std::string& path);
+    static void DrawImGui(bool* open = nullptr);
+};
+
+class ProfileScope {
+private:
+    const char* m_Name;
+    uint32_t m_Depth;
+    uint64_t m_Start;
+public:
+    explicit ProfileScope(const char* name) : m_Name(name), m_Depth(Profiler::PushDepth()), m_Start(Profiler::Now()) {}
+    ~ProfileScope() {
+        Profiler::RecordCpu(m_Name, m_Start, Profiler::Now(), m_Depth);
+        Profiler::PopDepth();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name) { Profiler::BeginGpu(name); }
+    ~GpuProfileScope() { Profiler::EndGpu(); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if PROFILING
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __COUNTER__)(name)
+    #define PROFILE_GPU_SCOPE(name) PROFILE_SCOPE(name);\
+        GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __COUNTER__)(name)
+#else
+    #define PROFILE_SCOPE(name)
+    #define PROFILE_GPU_SCOPE(name)
+#endif
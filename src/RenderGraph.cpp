@@ -0,0 +1,366 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <queue>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "Profiler.h"
+
+void RenderGraph::Builder::Read(ResourceID resource) {
+    ASSERT(resource < m_Graph.m_Resources.size());
+    m_Graph.m_Passes[m_Pass].Reads.push_back(resource);
+    m_Graph.m_Resources[resource].Readers.push_back(m_Pass);
+}
+
+void RenderGraph::Builder::Write(ResourceID resource) {
+    ASSERT(resource < m_Graph.m_Resources.size());
+    m_Graph.m_Passes[m_Pass].Writes.push_back(resource);
+    m_Graph.m_Resources[resource].Writers.push_back(m_Pass);
+}
+
+void RenderGraph::Builder::SetSideEffect() {
+    m_Graph.m_Passes[m_Pass].SideEffect = true;
+}
+
+void RenderGraph::Context::Bind(ResourceID resource, unsigned int slot) const {
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, GetTexture(resource));
+}
+
+unsigned int RenderGraph::Context::GetTexture(ResourceID resource) const {
+    const Resource& entry = m_Graph.m_Resources[resource];
+    if (entry.Imported)
+        return entry.Target ? entry.Target->GetColorAttachment() : 0;
+    return entry.Texture >= 0 ? m_Graph.m_Pool[entry.Texture].Target.GetRendererID() : 0;
+}
+
+const RenderTargetDescription &RenderGraph::Context::GetDescription(ResourceID resource) const {
+    return m_Graph.m_Resources[resource].Description;
+}
+
+void RenderGraph::Reset() {
+    m_Resources.clear();
+    m_Passes.clear();
+    m_Order.clear();
+    m_Compiled = false;
+}
+
+RenderGraph::ResourceID RenderGraph::Create(const std::string &name, const RenderTargetDescription &description) {
+    Resource resource;
+    resource.Name = name;
+    resource.Description = description;
+    m_Resources.push_back(std::move(resource));
+    m_Compiled = false;
+    return static_cast<ResourceID>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceID RenderGraph::Import(const std::string &name, Framebuffer *framebuffer, int width, int height) {
+    Resource resource;
+    resource.Name = name;
+    resource.Description = { width, height, RenderTargetFormat::RGBA8 };
+    resource.Imported = true;
+    resource.Target = framebuffer;
+    m_Resources.push_back(std::move(resource));
+    m_Compiled = false;
+    return static_cast<ResourceID>(m_Resources.size() - 1);
+}
+
+void RenderGraph::MarkOutput(ResourceID resource) {
+    ASSERT(resource < m_Resources.size());
+    m_Resources[resource].Output = true;
+    m_Compiled = false;
+}
+
+void RenderGraph::AddPass(const std::string &name, const SetupFunction &setup, ExecuteFunction execute) {
+    Pass pass;
+    pass.Name = name;
+    pass.Execute = std::move(execute);
+    m_Passes.push_back(std::move(pass));
+
+    Builder builder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+    setup(builder);
+    m_Compiled = false;
+}
+
+bool RenderGraph::Compile() {
+    PROFILE_SCOPE("RenderGraph::Compile");
+    m_Stats = {};
+    m_Stats.Passes = static_cast<unsigned int>(m_Passes.size());
+
+    Cull();
+    const bool acyclic = Sort();
+    AssignTextures();
+
+    for (const Pass& pass : m_Passes)
+        m_Stats.CulledPasses += pass.Culled;
+    m_Compiled = true;
+    return acyclic;
+}
+
+// Walks back from the passes whose results leave the graph; whatever they
+// don't reach, directly or through the targets they read, is culled
+void RenderGraph::Cull() {
+    std::vector<uint32_t> pending;
+    for (uint32_t i = 0; i < m_Passes.size(); i++) {
+        Pass& pass = m_Passes[i];
+        pass.Culled = !pass.SideEffect && std::none_of(pass.Writes.begin(), pass.Writes.end(), [this](ResourceID resource) {
+            return m_Resources[resource].Imported || m_Resources[resource].Output;
+        });
+        if (!pass.Culled)
+            pending.push_back(i);
+    }
+
+    while (!pending.empty()) {
+        const uint32_t index = pending.back();
+        pending.pop_back();
+        for (const ResourceID resource : m_Passes[index].Reads) {
+            for (const uint32_t writer : m_Resources[resource].Writers) {
+                if (m_Passes[writer].Culled) {
+                    m_Passes[writer].Culled = false;
+                    pending.push_back(writer);
+                }
+            }
+        }
+    }
+}
+
+// Every writer of a target runs before its readers, and writers of one
+// target run in the order they were added. Among passes free to run, the
+// earliest added goes first.
+bool RenderGraph::Sort() {
+    const auto passCount = static_cast<uint32_t>(m_Passes.size());
+    std::vector<std::vector<uint32_t>> successors(passCount);
+    std::vector<unsigned int> dependencies(passCount, 0);
+    const auto addEdge = [&](uint32_t from, uint32_t to) {
+        // A pass that reads what it writes, e.g. blending onto a target, needs no edge to itself
+        if (from == to || m_Passes[from].Culled || m_Passes[to].Culled)
+            return;
+        successors[from].push_back(to);
+        dependencies[to]++;
+    };
+
+    for (const Resource& resource : m_Resources) {
+        for (size_t i = 1; i < resource.Writers.size(); i++)
+            addEdge(resource.Writers[i - 1], resource.Writers[i]);
+        for (const uint32_t writer : resource.Writers) {
+            for (const uint32_t reader : resource.Readers)
+                addEdge(writer, reader);
+        }
+    }
+
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<>> ready;
+    for (uint32_t i = 0; i < passCount; i++) {
+        if (!m_Passes[i].Culled && dependencies[i] == 0)
+            ready.push(i);
+    }
+
+    m_Order.clear();
+    while (!ready.empty()) {
+        const uint32_t index = ready.top();
+        ready.pop();
+        m_Order.push_back(index);
+        for (const uint32_t successor : successors[index]) {
+            if (--dependencies[successor] == 0)
+                ready.push(successor);
+        }
+    }
+
+    bool acyclic = true;
+    for (uint32_t i = 0; i < passCount; i++) {
+        if (!m_Passes[i].Culled && dependencies[i] > 0) {
+            std::cout << "Render graph pass '" << m_Passes[i].Name << "' is part of a cycle and is skipped" << std::endl;
+            m_Passes[i].Culled = true;
+            acyclic = false;
+        }
+    }
+    return acyclic;
+}
+
+// Walks the schedule taking a pooled texture for each transient target at
+// its first use and returning it after its last, so a later target of the
+// same description can take it over
+void RenderGraph::AssignTextures() {
+    for (Resource& resource : m_Resources) {
+        resource.FirstUse = resource.LastUse = -1;
+        resource.Texture = -1;
+    }
+    for (int position = 0; position < static_cast<int>(m_Order.size()); position++) {
+        const Pass& pass = m_Passes[m_Order[position]];
+        for (const auto* list : { &pass.Reads, &pass.Writes }) {
+            for (const ResourceID id : *list) {
+                Resource& resource = m_Resources[id];
+                if (resource.FirstUse < 0)
+                    resource.FirstUse = position;
+                resource.LastUse = position;
+            }
+        }
+    }
+
+    ReleaseIdleTextures();
+
+    std::vector<bool> used(m_Pool.size(), false);
+    for (int position = 0; position < static_cast<int>(m_Order.size()); position++) {
+        for (Resource& resource : m_Resources) {
+            if (resource.Imported || resource.FirstUse != position)
+                continue;
+
+            auto it = std::find_if(m_Pool.begin(), m_Pool.end(), [&](const PooledTexture& texture) {
+                return !texture.Busy && texture.Target.GetDescription() == resource.Description;
+            });
+            if (it == m_Pool.end()) {
+                m_Pool.push_back({ RenderTarget(resource.Description) });
+                used.push_back(false);
+                it = m_Pool.end() - 1;
+                m_Stats.TexturesCreated++;
+            }
+            it->Busy = true;
+            it->IdleFrames = 0;
+            resource.Texture = static_cast<int>(it - m_Pool.begin());
+            used[resource.Texture] = true;
+
+            m_Stats.TransientTargets++;
+            m_Stats.TransientBytes += RenderTarget::GetMemorySize(resource.Description);
+        }
+
+        // Outputs hold their texture past the end of the frame
+        for (const Resource& resource : m_Resources) {
+            if (resource.Texture >= 0 && resource.LastUse == position && !resource.Output)
+                m_Pool[resource.Texture].Busy = false;
+        }
+    }
+
+    for (size_t i = 0; i < m_Pool.size(); i++) {
+        m_Pool[i].Busy = false;
+        if (used[i]) {
+            m_Stats.Textures++;
+            m_Stats.TextureBytes += RenderTarget::GetMemorySize(m_Pool[i].Target.GetDescription());
+        }
+    }
+}
+
+void RenderGraph::ReleaseIdleTextures() {
+    for (size_t i = 0; i < m_Pool.size();) {
+        if (++m_Pool[i].IdleFrames <= IdleFrameLimit) {
+            i++;
+            continue;
+        }
+
+        const unsigned int name = m_Pool[i].Target.GetRendererID();
+        std::erase_if(m_Framebuffers, [name](const auto& entry) {
+            return std::find(entry.first.begin(), entry.first.end(), name) != entry.first.end();
+        });
+        m_Pool.erase(m_Pool.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+}
+
+Framebuffer &RenderGraph::GetFramebuffer(const std::vector<ResourceID> &resources) {
+    std::vector<const RenderTarget*> colors;
+    const RenderTarget* depth = nullptr;
+    for (const ResourceID id : resources) {
+        const RenderTarget& target = m_Pool[m_Resources[id].Texture].Target;
+        if (target.IsDepth()) {
+            ASSERT(depth == nullptr);
+            depth = &target;
+        } else {
+            colors.push_back(&target);
+        }
+    }
+
+    std::vector<unsigned int> key;
+    for (const RenderTarget* color : colors)
+        key.push_back(color->GetRendererID());
+    key.push_back(depth ? depth->GetRendererID() : 0);
+
+    std::unique_ptr<Framebuffer>& framebuffer = m_Framebuffers[key];
+    if (!framebuffer)
+        framebuffer = std::make_unique<Framebuffer>(colors, depth);
+    return *framebuffer;
+}
+
+void RenderGraph::Execute() {
+    if (!m_Compiled)
+        Compile();
+
+    PROFILE_GPU_SCOPE("RenderGraph::Execute");
+    const Context context(*this);
+    for (int position = 0; position < static_cast<int>(m_Order.size()); position++) {
+        Pass& pass = m_Passes[m_Order[position]];
+        if (pass.Writes.empty()) {
+            pass.Execute(context);
+            continue;
+        }
+
+        const Resource& first = m_Resources[pass.Writes[0]];
+        if (first.Imported) {
+            // An imported framebuffer brings its own attachments
+            ASSERT(pass.Writes.size() == 1);
+            if (first.Target) {
+                first.Target->Bind();
+            } else {
+                GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+                GLCall(glViewport(0, 0, first.Description.Width, first.Description.Height));
+            }
+            pass.Execute(context);
+            continue;
+        }
+
+        // Attachments whose target starts or ends its life in this pass
+        unsigned int startingColors = 0, endingColors = 0, color = 0;
+        bool startingDepth = false, endingDepth = false;
+        for (const ResourceID id : pass.Writes) {
+            const Resource& resource = m_Resources[id];
+            const bool starting = resource.FirstUse == position;
+            const bool ending = resource.LastUse == position && !resource.Output;
+            if (RenderTarget::IsDepthFormat(resource.Description.Format)) {
+                startingDepth = starting;
+                endingDepth = ending;
+            } else {
+                startingColors |= starting ? 1u << color : 0;
+                endingColors |= ending ? 1u << color : 0;
+                color++;
+            }
+        }
+
+        Framebuffer& framebuffer = GetFramebuffer(pass.Writes);
+        const bool invalidate = Framebuffer::SupportsInvalidate();
+        if (invalidate && (startingColors || startingDepth)) {
+            framebuffer.Invalidate(startingColors, startingDepth);
+            m_Stats.Invalidations++;
+        }
+        framebuffer.Bind();
+        pass.Execute(context);
+        if (invalidate && (endingColors || endingDepth)) {
+            framebuffer.Invalidate(endingColors, endingDepth);
+            m_Stats.Invalidations++;
+        }
+    }
+}
+
+bool RenderGraph::ReadPixels(ResourceID resource, std::vector<unsigned char> &pixels) {
+    ASSERT(resource < m_Resources.size());
+    const Resource& entry = m_Resources[resource];
+    if (entry.Imported) {
+        if (!entry.Target)
+            return false;
+        entry.Target->ReadPixels(pixels);
+        return true;
+    }
+    if (!entry.Output || entry.Texture < 0 || RenderTarget::IsDepthFormat(entry.Description.Format))
+        return false;
+
+    GetFramebuffer({ resource }).ReadPixels(pixels);
+    return true;
+}
+
+std::vector<std::string> RenderGraph::GetSchedule() const {
+    std::vector<std::string> names;
+    for (const uint32_t index : m_Order)
+        names.push_back(m_Passes[index].Name);
+    return names;
+}
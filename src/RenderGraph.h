@@ -0,0 +1,151 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Framebuffer.h"
+#include "RenderTarget.h"
+
+// A frame described as passes that declare which render targets they read
+// and write. Compiling orders the passes so every writer of a target runs
+// before its readers, culls passes whose results nothing uses, and gives
+// transient targets textures from a pool, so targets whose lifetimes don't
+// overlap share one texture. Attachments are invalidated when a transient
+// target is first written and after its last use, so the driver can skip
+// loading and storing them.
+//
+// Rebuild the graph every frame: Reset, Create/Import, AddPass, Execute. The
+// texture pool and the framebuffers made from it outlive Reset.
+class RenderGraph {
+public:
+    using ResourceID = uint32_t;
+    static constexpr ResourceID InvalidResource = UINT32_MAX;
+    // Pooled textures unused for this many frames are freed
+    static constexpr unsigned int IdleFrameLimit = 3;
+
+    struct Stats {
+        unsigned int Passes = 0;
+        unsigned int CulledPasses = 0;
+        unsigned int TransientTargets = 0;
+        // Pool textures the transient targets were placed in
+        unsigned int Textures = 0;
+        unsigned int TexturesCreated = 0;
+        // Video memory the transient targets would take unaliased, and do take
+        uint64_t TransientBytes = 0;
+        uint64_t TextureBytes = 0;
+        unsigned int Invalidations = 0;
+    };
+
+    class Builder {
+    private:
+        RenderGraph& m_Graph;
+        uint32_t m_Pass;
+    public:
+        Builder(RenderGraph& graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+        // Sampled by the pass
+        void Read(ResourceID resource);
+        // Rendered into; color targets are attached in the order they are written
+        void Write(ResourceID resource);
+        // Never culled, for passes with effects outside the graph
+        void SetSideEffect();
+    };
+
+    class Context {
+    private:
+        const RenderGraph& m_Graph;
+    public:
+        explicit Context(const RenderGraph& graph) : m_Graph(graph) {}
+
+        void Bind(ResourceID resource, unsigned int slot) const;
+        unsigned int GetTexture(ResourceID resource) const;
+        const RenderTargetDescription& GetDescription(ResourceID resource) const;
+    };
+
+    using SetupFunction = std::function<void(Builder&)>;
+    using ExecuteFunction = std::function<void(const Context&)>;
+private:
+    struct Resource {
+        std::string Name;
+        RenderTargetDescription Description;
+        bool Imported = false;
+        Framebuffer* Target = nullptr; // Imported only; nullptr is the default framebuffer
+        bool Output = false;
+        std::vector<uint32_t> Writers;
+        std::vector<uint32_t> Readers;
+        // Positions in m_Order of the first and last pass using it
+        int FirstUse = -1;
+        int LastUse = -1;
+        int Texture = -1; // Index into m_Pool
+    };
+
+    struct Pass {
+        std::string Name;
+        ExecuteFunction Execute;
+        std::vector<ResourceID> Reads;
+        std::vector<ResourceID> Writes;
+        bool SideEffect = false;
+        bool Culled = false;
+    };
+
+    struct PooledTexture {
+        RenderTarget Target;
+        bool Busy = false;
+        unsigned int IdleFrames = 0;
+    };
+
+    std::vector<Resource> m_Resources;
+    std::vector<Pass> m_Passes;
+    std::vector<uint32_t> m_Order;
+    bool m_Compiled = false;
+
+    std::vector<PooledTexture> m_Pool;
+    // Keyed by the attached texture names, colors then depth
+    std::map<std::vector<unsigned int>, std::unique_ptr<Framebuffer>> m_Framebuffers;
+    Stats m_Stats;
+public:
+    RenderGraph() = default;
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Drops the passes and resources of the last frame
+    void Reset();
+
+    // A target that only lives while the frame renders
+    ResourceID Create(const std::string& name, const RenderTargetDescription& description);
+    // A framebuffer owned outside the graph, or the default one for nullptr.
+    // Passes writing it are never culled.
+    ResourceID Import(const std::string& name, Framebuffer* framebuffer, int width, int height);
+    // Keeps a transient target intact after Execute, for ReadPixels
+    void MarkOutput(ResourceID resource);
+
+    void AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+    // Orders, culls and places the passes; Execute does it if needed. Returns
+    // false if reads and writes form a cycle, whose passes are then skipped.
+    bool Compile();
+    void Execute();
+
+    // RGBA8 rows of an output or imported target after Execute, bottom row first
+    bool ReadPixels(ResourceID resource, std::vector<unsigned char>& pixels);
+
+    // Pass names in the order they run, culled passes left out
+    std::vector<std::string> GetSchedule() const;
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    void Cull();
+    bool Sort();
+    void AssignTextures();
+    void ReleaseIdleTextures();
+    Framebuffer& GetFramebuffer(const std::vector<ResourceID>& resources);
+};
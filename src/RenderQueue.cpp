@@ -0,0 +1,182 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "Profiler.h"
+#include "Texture.h"
+
+static std::atomic<uint64_t> s_NextQueueID{ 1 };
+
+// The last buffer this thread used, so Submit skips the lock after the first call
+struct CachedCommandBuffer {
+    uint64_t QueueID = 0;
+    RenderQueue::CommandBuffer* Buffer = nullptr;
+};
+static thread_local CachedCommandBuffer t_CachedBuffer;
+
+uint64_t RenderKey::Make(uint8_t layer, unsigned int program, unsigned int texture, unsigned int vertexArray, float depth) {
+    constexpr uint64_t depthMax = (1u << 20) - 1;
+    const uint64_t quantizedDepth = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * depthMax);
+    return static_cast<uint64_t>(layer) << 56
+         | static_cast<uint64_t>(program & 0xFFF) << 44
+         | static_cast<uint64_t>(texture & 0xFFF) << 32
+         | static_cast<uint64_t>(vertexArray & 0xFFF) << 20
+         | quantizedDepth;
+}
+
+void RenderQueue::CommandBuffer::Submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                                        UniformHandle<glm::mat4> modelHandle, const glm::mat4& model, uint8_t layer, float depth) {
+    const unsigned int textureID = texture ? texture->GetRendererID() : 0;
+    m_Keys.push_back(RenderKey::Make(layer, shader.GetRendererID(), textureID, va.GetRendererID(), depth));
+    m_Commands.push_back({ shader.GetRendererID(), va.GetRendererID(), ib.GetRendererID(), textureID,
+                           ib.GetCount(), ib.GetType(), 1, modelHandle.Location, model });
+}
+
+void RenderQueue::CommandBuffer::SubmitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                                                 unsigned int instanceCount, uint8_t layer, float depth) {
+    const unsigned int textureID = texture ? texture->GetRendererID() : 0;
+    m_Keys.push_back(RenderKey::Make(layer, shader.GetRendererID(), textureID, va.GetRendererID(), depth));
+    m_Commands.push_back({ shader.GetRendererID(), va.GetRendererID(), ib.GetRendererID(), textureID,
+                           ib.GetCount(), ib.GetType(), instanceCount, -1, glm::mat4(1.0f) });
+}
+
+RenderQueue::RenderQueue() : m_ID(s_NextQueueID.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+RenderQueue::CommandBuffer& RenderQueue::GetCommandBuffer() {
+    if (t_CachedBuffer.QueueID == m_ID)
+        return *t_CachedBuffer.Buffer;
+
+    std::lock_guard<std::mutex> lock(m_BufferMutex);
+    const std::thread::id thread = std::this_thread::get_id();
+    auto it = std::find_if(m_Buffers.begin(), m_Buffers.end(), [&](const auto& entry) { return entry.first == thread; });
+    if (it == m_Buffers.end()) {
+        m_Buffers.emplace_back(thread, std::make_unique<CommandBuffer>());
+        it = m_Buffers.end() - 1;
+    }
+
+    t_CachedBuffer = { m_ID, it->second.get() };
+    return *it->second;
+}
+
+void RenderQueue::Submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                         UniformHandle<glm::mat4> modelHandle, const glm::mat4& model, uint8_t layer, float depth) {
+    GetCommandBuffer().Submit(va, ib, shader, texture, modelHandle, model, layer, depth);
+}
+
+void RenderQueue::SubmitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                                  unsigned int instanceCount, uint8_t layer, float depth) {
+    GetCommandBuffer().SubmitInstanced(va, ib, shader, texture, instanceCount, layer, depth);
+}
+
+void RenderQueue::Merge() {
+    m_Commands.clear();
+    m_SortEntries.clear();
+
+    std::lock_guard<std::mutex> lock(m_BufferMutex);
+    for (const auto& [thread, buffer] : m_Buffers) {
+        const size_t first = m_Commands.size();
+        m_Commands.insert(m_Commands.end(), buffer->m_Commands.begin(), buffer->m_Commands.end());
+        for (size_t i = 0; i < buffer->m_Keys.size(); i++)
+            m_SortEntries.push_back({ buffer->m_Keys[i], static_cast<uint32_t>(first + i) });
+
+        buffer->m_Keys.clear();
+        buffer->m_Commands.clear();
+    }
+}
+
+// LSD radix sort, one byte per pass. All eight histograms are built in a single
+// read, and a pass is skipped when every key has the same byte there (unused
+// layers, a single shader, ...), so typical frames take only a few passes.
+void RenderQueue::Sort() {
+    PROFILE_SCOPE("RenderQueue::Sort");
+
+    const size_t count = m_SortEntries.size();
+    if (count < 2)
+        return;
+
+    uint32_t histograms[8][256] = {};
+    for (const SortEntry& entry : m_SortEntries) {
+        for (int pass = 0; pass < 8; pass++)
+            histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
+    }
+
+    m_SortScratch.resize(count);
+    SortEntry* source = m_SortEntries.data();
+    SortEntry* destination = m_SortScratch.data();
+    for (int pass = 0; pass < 8; pass++) {
+        uint32_t* histogram = histograms[pass];
+        const uint32_t firstByte = (source[0].Key >> (pass * 8)) & 0xFF;
+        if (histogram[firstByte] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            const uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; i++)
+            destination[histogram[(source[i].Key >> (pass * 8)) & 0xFF]++] = source[i];
+        std::swap(source, destination);
+    }
+
+    if (source != m_SortEntries.data())
+        std::memcpy(m_SortEntries.data(), source, count * sizeof(SortEntry));
+}
+
+void RenderQueue::Execute() {
+    PROFILE_GPU_SCOPE("RenderQueue::Execute");
+
+    Merge();
+    Sort();
+
+    m_Stats = {};
+    m_Stats.Commands = static_cast<unsigned int>(m_SortEntries.size());
+
+    // Only touch GL state where it differs from the previous command
+    unsigned int program = 0;
+    unsigned int texture = 0;
+    unsigned int vertexArray = 0;
+    unsigned int indexBuffer = 0;
+    for (const SortEntry& entry : m_SortEntries) {
+        const RenderCommand& command = m_Commands[entry.Index];
+        if (command.Program != program) {
+            GLStateCache::UseProgram(command.Program);
+            program = command.Program;
+            m_Stats.ProgramChanges++;
+        }
+        if (command.Texture != 0 && command.Texture != texture) {
+            GLStateCache::BindTexture(0, GL_TEXTURE_2D, command.Texture);
+            texture = command.Texture;
+            m_Stats.TextureChanges++;
+        }
+        if (command.VertexArray != vertexArray) {
+            GLStateCache::BindVertexArray(command.VertexArray);
+            vertexArray = command.VertexArray;
+            indexBuffer = 0;
+            m_Stats.VertexArrayChanges++;
+        }
+        if (command.IndexBuffer != indexBuffer) {
+            GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, command.IndexBuffer);
+            indexBuffer = command.IndexBuffer;
+        }
+
+        if (command.ModelLocation != -1) {
+            GLCall(glUniformMatrix4fv(command.ModelLocation, 1, GL_FALSE, &command.Model[0][0]));
+        }
+        if (command.InstanceCount == 1) {
+            GLCall(glDrawElements(GL_TRIANGLES, command.IndexCount, command.IndexType, nullptr));
+        } else {
+            GLCall(glDrawElementsInstanced(GL_TRIANGLES, command.IndexCount, command.IndexType, nullptr, command.InstanceCount));
+        }
+    }
+}
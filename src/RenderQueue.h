@@ -0,0 +1,107 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+
+class VertexArray;
+class IndexBuffer;
+class Texture;
+
+// Everything needed to issue one draw, recorded by value so it can be sorted
+// and replayed later. GL names only; the objects must outlive Execute.
+struct RenderCommand {
+    unsigned int Program;
+    unsigned int VertexArray;
+    unsigned int IndexBuffer;
+    unsigned int Texture;  // 0 leaves slot 0 alone
+    unsigned int IndexCount;
+    unsigned int IndexType;
+    unsigned int InstanceCount;
+    int ModelLocation;     // -1 when the draw has no model matrix
+    glm::mat4 Model;
+};
+
+static_assert(std::is_trivially_copyable_v<RenderCommand>, "RenderCommand must stay POD");
+
+// 64-bit sort key, most significant first:
+//   layer (8) | shader (12) | texture (12) | vertex array (12) | depth (20)
+// Object names are truncated to 12 bits, so two names may share a bucket;
+// that only costs a state change, never correctness.
+struct RenderKey {
+    static uint64_t Make(uint8_t layer, unsigned int program, unsigned int texture, unsigned int vertexArray, float depth);
+};
+
+class RenderQueue {
+public:
+    struct Stats {
+        unsigned int Commands = 0;
+        unsigned int ProgramChanges = 0;
+        unsigned int TextureChanges = 0;
+        unsigned int VertexArrayChanges = 0;
+    };
+
+    // Commands recorded by one thread. Not thread safe by itself; every thread
+    // gets its own from RenderQueue::GetCommandBuffer.
+    class CommandBuffer {
+    private:
+        std::vector<uint64_t> m_Keys;
+        std::vector<RenderCommand> m_Commands;
+    public:
+        void Submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                    UniformHandle<glm::mat4> modelHandle, const glm::mat4& model, uint8_t layer = 0, float depth = 0.0f);
+        void SubmitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                             unsigned int instanceCount, uint8_t layer = 0, float depth = 0.0f);
+
+        inline size_t GetCommandCount() const { return m_Commands.size(); }
+
+        friend class RenderQueue;
+    };
+
+private:
+    struct SortEntry {
+        uint64_t Key;
+        uint32_t Index;
+    };
+
+    std::mutex m_BufferMutex;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>> m_Buffers;
+    std::vector<RenderCommand> m_Commands;
+    std::vector<SortEntry> m_SortEntries;
+    std::vector<SortEntry> m_SortScratch;
+    Stats m_Stats;
+    uint64_t m_ID;
+public:
+    RenderQueue();
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // The calling thread's command buffer, created on first use
+    CommandBuffer& GetCommandBuffer();
+
+    void Submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                UniformHandle<glm::mat4> modelHandle, const glm::mat4& model, uint8_t layer = 0, float depth = 0.0f);
+    void SubmitInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+                         unsigned int instanceCount, uint8_t layer = 0, float depth = 0.0f);
+
+    // Merges every command buffer, sorts by key and draws. Must run on the
+    // context thread once all submitting threads are done for the frame.
+    void Execute();
+
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    void Merge();
+    void Sort();
+};
@@ -0,0 +1,74 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "RenderTarget.h"
+
+#include <utility>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
+
+struct TargetFormat {
+    unsigned int InternalFormat;
+    unsigned int Format;
+    unsigned int Type;
+    unsigned int Size; // Bytes per texel
+};
+
+static TargetFormat GetTargetFormat(RenderTargetFormat format) {
+    switch (format) {
+        case RenderTargetFormat::RGBA8: return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4 };
+        case RenderTargetFormat::RGBA16F: return { GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8 };
+        case RenderTargetFormat::R32F: return { GL_R32F, GL_RED, GL_FLOAT, 4 };
+        case RenderTargetFormat::Depth24Stencil8: return { GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4 };
+        case RenderTargetFormat::Depth32F: return { GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, 4 };
+    }
+    return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4 };
+}
+
+RenderTarget::RenderTarget(const RenderTargetDescription &description)
+    : m_RendererID(GLObjectPool::CreateTexture()), m_Description(description) {
+    const TargetFormat format = GetTargetFormat(description.Format);
+    const unsigned int filter = IsDepth() ? GL_NEAREST : GL_LINEAR;
+
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, format.InternalFormat, description.Width, description.Height, 0,
+                        format.Format, format.Type, nullptr));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
+}
+
+RenderTarget::~RenderTarget() {
+    GLObjectPool::DestroyTexture(m_RendererID);
+}
+
+RenderTarget::RenderTarget(RenderTarget &&other) noexcept
+    : m_RendererID(std::exchange(other.m_RendererID, 0)), m_Description(other.m_Description) {
+}
+
+RenderTarget &RenderTarget::operator=(RenderTarget &&other) noexcept {
+    if (this != &other) {
+        GLObjectPool::DestroyTexture(m_RendererID);
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_Description = other.m_Description;
+    }
+    return *this;
+}
+
+void RenderTarget::Bind(unsigned int slot) const {
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
+}
+
+bool RenderTarget::IsDepthFormat(RenderTargetFormat format) {
+    return format == RenderTargetFormat::Depth24Stencil8 || format == RenderTargetFormat::Depth32F;
+}
+
+unsigned int RenderTarget::GetMemorySize(const RenderTargetDescription &description) {
+    return static_cast<unsigned int>(description.Width) * description.Height * GetTargetFormat(description.Format).Size;
+}
@@ -0,0 +1,49 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+enum class RenderTargetFormat {
+    RGBA8,
+    RGBA16F,
+    R32F,
+    Depth24Stencil8,
+    Depth32F
+};
+
+struct RenderTargetDescription {
+    int Width = 0;
+    int Height = 0;
+    RenderTargetFormat Format = RenderTargetFormat::RGBA8;
+
+    bool operator==(const RenderTargetDescription&) const = default;
+};
+
+// A texture that is rendered into through a Framebuffer and sampled by
+// later draws. Color targets filter linearly, depth targets are nearest.
+class RenderTarget {
+private:
+    unsigned int m_RendererID;
+    RenderTargetDescription m_Description;
+public:
+    explicit RenderTarget(const RenderTargetDescription& description);
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+    RenderTarget(RenderTarget&& other) noexcept;
+    RenderTarget& operator=(RenderTarget&& other) noexcept;
+
+    void Bind(unsigned int slot = 0) const;
+
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+    inline const RenderTargetDescription& GetDescription() const { return m_Description; }
+    inline int GetWidth() const { return m_Description.Width; }
+    inline int GetHeight() const { return m_Description.Height; }
+    inline bool IsDepth() const { return IsDepthFormat(m_Description.Format); }
+
+    static bool IsDepthFormat(RenderTargetFormat format);
+    // Bytes of video memory one target of this description takes
+    static unsigned int GetMemorySize(const RenderTargetDescription& description);
+};
@@ -3,8 +3,13 @@
 //
 
 #include "Renderer.h"
+#include "GLObjectPool.h"
+#include "Profiler.h"
+#include <atomic>
 #include <iostream>
 
+static std::atomic<const GLCallSite*> s_LastCallSite{ nullptr };
+
 void GLClearError() {
     while (glGetError() != GL_NO_ERROR);
 }
@@ -17,14 +22,78 @@ bool GLLogCall(const char* function, const char* file, const int line) {
     return true;
 }
 
+void GLSetCallSite(const GLCallSite* site) {
+    s_LastCallSite.store(site, std::memory_order_relaxed);
+}
+
+static void GLAPIENTRY GLDebugMessageCallback(GLenum, GLenum type, GLuint id, GLenum, GLsizei, const GLchar* message, const void*) {
+    const char* label = type == GL_DEBUG_TYPE_ERROR ? "[OpenGL Error]" : "[OpenGL Debug]";
+    std::cerr << label << " (" << id << "): " << message;
+
+    if (const GLCallSite* site = s_LastCallSite.load(std::memory_order_relaxed))
+        std::cerr << " near " << site->Function << " " << site->File << ":" << site->Line;
+    std::cerr << std::endl;
+}
+
+bool GLEnableDebugOutput(const bool synchronous) {
+    if (!GLEW_KHR_debug && !GLEW_VERSION_4_3)
+        return false;
+
+    glEnable(GL_DEBUG_OUTPUT);
+    if (synchronous)
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    else
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+
+    glDebugMessageCallback(GLDebugMessageCallback, nullptr);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+    return true;
+}
+
+Renderer::Renderer() : m_FrameUniforms(sizeof(FrameUniforms), FrameUniformBinding) {
+}
+
+void Renderer::BeginFrame(const glm::mat4& view, const glm::mat4& projection, const float time, const float deltaTime) {
+    const FrameUniforms frame{ view, projection, projection * view, glm::vec4(time, deltaTime, 0.0f, 0.0f) };
+    m_FrameUniforms.SetData(&frame, sizeof(FrameUniforms));
+    m_FrameUniforms.Bind();
+
+    GLObjectPool::Collect();
+}
+
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const {
+    PROFILE_GPU_SCOPE("Renderer::Draw");
     shader.Bind();
     va.Bind();
     ib.Bind();
 
-    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr));
+    m_Stats.DrawCalls++;
+    m_Stats.Instances++;
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const unsigned int instanceCount) const {
+    PROFILE_GPU_SCOPE("Renderer::DrawInstanced");
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr, instanceCount));
+    m_Stats.DrawCalls++;
+    m_Stats.Instances += instanceCount;
+}
+
+void Renderer::DrawFullscreen(const Shader& shader) const {
+    PROFILE_GPU_SCOPE("Renderer::DrawFullscreen");
+    shader.Bind();
+    m_EmptyVertexArray.Bind();
+
+    GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+    m_Stats.DrawCalls++;
+    m_Stats.Instances++;
 }
 
-void Renderer::Clear() const {
-    GLCall(glClear(GL_COLOR_BUFFER_BIT));
+void Renderer::Clear(unsigned int mask) const {
+    PROFILE_GPU_SCOPE("Renderer::Clear");
+    GLCall(glClear(mask));
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "VertexArray.h"
 #include "IndexBuffer.h"
 #include "Shader.h"
+#include "UniformBuffer.h"
 
 // Platform-specific debug break
 #ifdef __linux__
@@ -19,15 +20,70 @@
 #endif
 
 #define ASSERT(x) if (!(x)) debugBreak();
-#define GLCall(x) GLClearError();\
-    x;\
-    ASSERT(GLLogCall(#x, __FILE__, __LINE__));
+
+// OpenGL error checking, selected with the MODERNOPENGL_GL_CHECKS CMake option:
+//   GL_CHECKS_OFF            GLCall is the bare call
+//   GL_CHECKS_GETERROR       glGetError around every call (synchronous, slow)
+//   GL_CHECKS_DEBUG_CALLBACK KHR_debug callback, GLCall only records its call site
+#define GL_CHECKS_OFF 0
+#define GL_CHECKS_GETERROR 1
+#define GL_CHECKS_DEBUG_CALLBACK 2
+
+#ifndef GL_CHECKS
+    #define GL_CHECKS GL_CHECKS_GETERROR
+#endif
+
+struct GLCallSite {
+    const char* Function;
+    const char* File;
+    int Line;
+};
+
+#if GL_CHECKS == GL_CHECKS_GETERROR
+    #define GLCall(x) GLClearError();\
+        x;\
+        ASSERT(GLLogCall(#x, __FILE__, __LINE__));
+#elif GL_CHECKS == GL_CHECKS_DEBUG_CALLBACK
+    #define GLCall(x) GLSetCallSite([]() -> const GLCallSite* {\
+            static constexpr GLCallSite site{ #x, __FILE__, __LINE__ }; return &site; }());\
+        x;
+#else
+    #define GLCall(x) x;
+#endif
 
 void GLClearError();
 bool GLLogCall(const char* function, const char* file, int line);
+void GLSetCallSite(const GLCallSite* site);
+
+// Registers a glDebugMessageCallback that reports errors with the most recent
+// GLCall site. Asynchronous output keeps the driver from syncing; synchronous
+// output makes the reported call site exact. Returns false without KHR_debug.
+bool GLEnableDebugOutput(bool synchronous = false);
 
 class Renderer {
 public:
-    void Clear() const;
+    struct Stats {
+        unsigned int DrawCalls = 0;
+        unsigned int Instances = 0;
+    };
+private:
+    UniformBuffer m_FrameUniforms;
+    VertexArray m_EmptyVertexArray;
+    mutable Stats m_Stats;
+public:
+    Renderer();
+
+    // Uploads the camera and time once for every shader with a "Frame" block,
+    // and frees GL objects released in earlier frames that the GPU is done with
+    void BeginFrame(const glm::mat4& view, const glm::mat4& projection, float time, float deltaTime);
+
+    // GL_COLOR_BUFFER_BIT and/or GL_DEPTH_BUFFER_BIT, GL_STENCIL_BUFFER_BIT
+    void Clear(unsigned int mask = GL_COLOR_BUFFER_BIT) const;
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+    void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
+    // One triangle covering the viewport, for shaders that build it from gl_VertexID
+    void DrawFullscreen(const Shader& shader) const;
+
+    inline const Stats& GetStats() const { return m_Stats; }
+    inline void ResetStats() { m_Stats = {}; }
 };
\ No newline at end of file
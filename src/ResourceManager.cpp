@@ -0,0 +1,71 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "ResourceManager.h"
+
+#include <filesystem>
+
+// Two loads of one file with different sampling or formats are different textures
+static std::string GetTextureKey(const std::string& path, const TextureSpecification& specification) {
+    return ResourceManager::NormalizePath(path) + '|' + std::to_string(specification.MinFilter) + '|' + std::to_string(specification.MagFilter)
+         + '|' + std::to_string(specification.Wrap) + '|' + std::to_string(static_cast<int>(specification.Mipmaps))
+         + '|' + std::to_string(static_cast<int>(specification.Format)) + (specification.UseCache ? "|cached" : "");
+}
+
+template<typename T, typename... Args>
+ResourceHandle<T> ResourceManager::Acquire(Registry<T>& registry, std::string_view key, Args&&... args) {
+    const auto it = registry.ByKey.find(key);
+    if (it != registry.ByKey.end()) {
+        registry.References[it->second.Index]++;
+        m_Stats.Hits++;
+        return it->second;
+    }
+
+    const ResourceHandle<T> handle = registry.Pool.Create(std::forward<Args>(args)...);
+    if (!registry.Pool.Get(handle)->IsValid()) {
+        registry.Pool.Destroy(handle);
+        return {};
+    }
+    if (handle.Index >= registry.Keys.size()) {
+        registry.Keys.resize(handle.Index + 1);
+        registry.References.resize(handle.Index + 1);
+    }
+    registry.Keys[handle.Index] = key;
+    registry.References[handle.Index] = 1;
+    registry.ByKey.emplace(key, handle);
+    m_Stats.Loads++;
+    return handle;
+}
+
+template<typename T>
+void ResourceManager::Release(Registry<T>& registry, ResourceHandle<T> handle) {
+    if (!registry.Pool.Get(handle) || --registry.References[handle.Index] > 0)
+        return;
+
+    registry.ByKey.erase(registry.Keys[handle.Index]);
+    registry.Keys[handle.Index].clear();
+    registry.Pool.Destroy(handle);
+}
+
+std::string ResourceManager::NormalizePath(const std::string &path) {
+    std::error_code error;
+    const std::filesystem::path normalized = std::filesystem::weakly_canonical(path, error);
+    return (error ? std::filesystem::path(path).lexically_normal() : normalized).generic_string();
+}
+
+ResourceHandle<Texture> ResourceManager::LoadTexture(const std::string &path, const TextureSpecification &specification) {
+    return Acquire(m_Textures, GetTextureKey(path, specification), path, specification);
+}
+
+ResourceHandle<Shader> ResourceManager::LoadShader(const std::string &path) {
+    return Acquire(m_Shaders, NormalizePath(path), path);
+}
+
+void ResourceManager::Release(ResourceHandle<Texture> handle) {
+    Release(m_Textures, handle);
+}
+
+void ResourceManager::Release(ResourceHandle<Shader> handle) {
+    Release(m_Shaders, handle);
+}
@@ -0,0 +1,71 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ResourcePool.h"
+#include "Shader.h"
+#include "StringHash.h"
+#include "Texture.h"
+
+// Loads textures and shaders by path and hands out generational handles.
+// Loading a path that is already resident returns the same handle and bumps
+// its reference count; the resource is destroyed when the last reference is
+// released, and its GL objects are freed once the GPU is done with them.
+// Paths are compared after normalizing, so "res/a.png" and "./res/a.png" are
+// one resource. Failed loads are not kept and return an invalid handle.
+class ResourceManager {
+public:
+    struct Stats {
+        unsigned int Loads = 0;
+        unsigned int Hits = 0;
+    };
+
+private:
+    template<typename T>
+    struct Registry {
+        ResourcePool<T> Pool;
+        std::unordered_map<std::string, ResourceHandle<T>, StringHash, std::equal_to<>> ByKey;
+        // Indexed by handle index
+        std::vector<std::string> Keys;
+        std::vector<unsigned int> References;
+    };
+
+    Registry<Texture> m_Textures;
+    Registry<Shader> m_Shaders;
+    Stats m_Stats;
+public:
+    ResourceManager() = default;
+
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    // The form paths are compared in: absolute, with "." and ".." resolved
+    static std::string NormalizePath(const std::string& path);
+
+    ResourceHandle<Texture> LoadTexture(const std::string& path, const TextureSpecification& specification = TextureSpecification());
+    ResourceHandle<Shader> LoadShader(const std::string& path);
+
+    void Release(ResourceHandle<Texture> handle);
+    void Release(ResourceHandle<Shader> handle);
+
+    // nullptr once the handle has been released for the last time
+    inline Texture* Get(ResourceHandle<Texture> handle) { return m_Textures.Pool.Get(handle); }
+    inline Shader* Get(ResourceHandle<Shader> handle) { return m_Shaders.Pool.Get(handle); }
+
+    inline size_t GetTextureCount() const { return m_Textures.Pool.GetCount(); }
+    inline size_t GetShaderCount() const { return m_Shaders.Pool.GetCount(); }
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    template<typename T, typename... Args>
+    ResourceHandle<T> Acquire(Registry<T>& registry, std::string_view key, Args&&... args);
+    template<typename T>
+    void Release(Registry<T>& registry, ResourceHandle<T> handle);
+};
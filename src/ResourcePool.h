@@ -0,0 +1,87 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Index into a ResourcePool plus the generation of the slot it was issued for.
+// Once the resource is destroyed the slot's generation moves on, so stale
+// handles resolve to nothing instead of to whatever reused the slot.
+template<typename T>
+struct ResourceHandle {
+    uint32_t Index = 0;
+    uint32_t Generation = 0; // Never issued, so a default handle is invalid
+
+    inline bool IsValid() const { return Generation != 0; }
+    bool operator==(const ResourceHandle&) const = default;
+};
+
+// Owns move-only resources in contiguous slots. Pointers returned by Get are
+// only valid until the next Create, which may grow the storage.
+template<typename T>
+class ResourcePool {
+private:
+    struct Slot {
+        std::optional<T> Value;
+        uint32_t Generation = 1;
+    };
+
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+public:
+    template<typename... Args>
+    ResourceHandle<T> Create(Args&&... args) {
+        uint32_t index;
+        if (!m_FreeSlots.empty()) {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+
+        Slot& slot = m_Slots[index];
+        slot.Value.emplace(std::forward<Args>(args)...);
+        return { index, slot.Generation };
+    }
+
+    T* Get(ResourceHandle<T> handle) {
+        if (handle.Index >= m_Slots.size())
+            return nullptr;
+        Slot& slot = m_Slots[handle.Index];
+        return slot.Generation == handle.Generation && slot.Value ? &*slot.Value : nullptr;
+    }
+
+    const T* Get(ResourceHandle<T> handle) const {
+        return const_cast<ResourcePool*>(this)->Get(handle);
+    }
+
+    // Returns false for stale handles
+    bool Destroy(ResourceHandle<T> handle) {
+        if (!Get(handle))
+            return false;
+
+        Slot& slot = m_Slots[handle.Index];
+        slot.Value.reset();
+        if (++slot.Generation == 0)
+            slot.Generation = 1;
+        m_FreeSlots.push_back(handle.Index);
+        return true;
+    }
+
+    // Calls function(handle, resource) for every live resource
+    template<typename Function>
+    void ForEach(Function function) {
+        for (uint32_t i = 0; i < m_Slots.size(); i++) {
+            if (m_Slots[i].Value)
+                function(ResourceHandle<T>{ i, m_Slots[i].Generation }, *m_Slots[i].Value);
+        }
+    }
+
+    inline size_t GetCount() const { return m_Slots.size() - m_FreeSlots.size(); }
+};
@@ -4,31 +4,265 @@
 
 #include "Shader.h"
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <utility>
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
+#include "Profiler.h"
+#include "UniformBuffer.h"
+
+static constexpr char s_BinaryMagic[4] = { 'M', 'O', 'G', 'S' };
+static constexpr unsigned int s_BinaryVersion = 1;
+static constexpr auto s_ReloadPollInterval = std::chrono::milliseconds(250);
+
+struct ProgramBinaryHeader {
+    char Magic[4];
+    unsigned int Version;
+    unsigned int Format;
+    unsigned int Length;
+};
+
+// Drivers may advertise the extension but accept no formats at all
+static bool IsProgramBinarySupported() {
+    static const bool supported = [] {
+        if (!GLEW_ARB_get_program_binary)
+            return false;
+        int formats = 0;
+        GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+        return formats > 0;
+    }();
+    return supported;
+}
+
+static bool IsParallelCompileSupported() {
+    static const bool supported = [] {
+        if (!GLEW_KHR_parallel_shader_compile)
+            return false;
+        // Let the driver use as many compiler threads as it wants
+        GLCall(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+        return true;
+    }();
+    return supported;
+}
+
+// Binaries are only valid for the driver that produced them, so the driver
+// strings are part of the key next to the sources
+static uint64_t GetCacheKey(const ShaderProgramSource& source) {
+    uint64_t key = HashFNV1a(source.VertexSource);
+    key = HashFNV1a(std::string_view("\0", 1), key);
+    key = HashFNV1a(source.FragmentSource, key);
+    key = HashFNV1a(std::string_view("\0", 1), key);
+    key = HashFNV1a(source.ComputeSource, key);
+    for (const unsigned int name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        GLCall(const char* value = reinterpret_cast<const char*>(glGetString(name)));
+        key = HashFNV1a(std::string_view("\0", 1), key);
+        key = HashFNV1a(value ? value : "", key);
+    }
+    return key;
+}
+
+static std::string GetBinaryCachePath(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return std::string("cache/shaders/") + name;
+}
+
+// Returns 0 when there is no cached binary or the driver rejects it
+// (e.g. after a driver update), in which case the caller compiles from source
+static unsigned int LoadProgramBinary(uint64_t key) {
+    std::ifstream stream(GetBinaryCachePath(key), std::ios::binary);
+    ProgramBinaryHeader header{};
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return 0;
+    if (std::memcmp(header.Magic, s_BinaryMagic, sizeof(s_BinaryMagic)) != 0 || header.Version != s_BinaryVersion)
+        return 0;
+
+    std::vector<char> binary(header.Length);
+    if (!stream.read(binary.data(), header.Length))
+        return 0;
+
+    GLCall(unsigned int program = glCreateProgram());
+    // A rejected binary only fails the link status, it doesn't raise an error
+    GLCall(glProgramBinary(program, header.Format, binary.data(), header.Length));
+    int linked = GL_FALSE;
+    GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE) {
+        GLCall(glDeleteProgram(program));
+        return 0;
+    }
+    return program;
+}
+
+static void SaveProgramBinary(unsigned int program, uint64_t key) {
+    int length = 0;
+    GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0)
+        return;
+
+    ProgramBinaryHeader header{};
+    std::memcpy(header.Magic, s_BinaryMagic, sizeof(s_BinaryMagic));
+    header.Version = s_BinaryVersion;
+    std::vector<char> binary(length);
+    GLCall(glGetProgramBinary(program, length, &length, &header.Format, binary.data()));
+    header.Length = length;
+
+    const std::string path = GetBinaryCachePath(key);
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+    std::ofstream stream(path, std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(binary.data(), length);
+}
+
+static bool CheckCompileStatus(unsigned int id, unsigned int type) {
+    int result;
+    GLCall(glGetShaderiv(id, GL_COMPILE_STATUS, &result));
+    if (result == GL_FALSE) {
+        int length;
+        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+        char* message = static_cast<char*>(alloca(length * sizeof(char)));  // C++ cast
+        glGetShaderInfoLog(id, length, &length, message);
+        const char* typeName = type == GL_VERTEX_SHADER ? "vertex" : type == GL_FRAGMENT_SHADER ? "fragment" : "compute";
+        std::cout << "Failed to compile " << typeName << " shader!" << std::endl;
+        std::cout << message << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Uniforms set with a single int: ints, bools and every sampler, whose value
+// is the texture unit
+static bool IsIntUniformType(unsigned int type) {
+    switch (type) {
+        case GL_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_1D_SHADOW:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_CUBE_SHADOW:
+        case GL_SAMPLER_1D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_1D_ARRAY_SHADOW:
+        case GL_SAMPLER_2D_ARRAY_SHADOW:
+        case GL_SAMPLER_2D_MULTISAMPLE:
+        case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+        case GL_SAMPLER_BUFFER:
+        case GL_SAMPLER_2D_RECT:
+        case GL_INT_SAMPLER_2D:
+        case GL_INT_SAMPLER_3D:
+        case GL_INT_SAMPLER_CUBE:
+        case GL_INT_SAMPLER_2D_ARRAY:
+        case GL_INT_SAMPLER_BUFFER:
+        case GL_UNSIGNED_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_3D:
+        case GL_UNSIGNED_INT_SAMPLER_CUBE:
+        case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+        case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Carries the values of the default block uniforms (samplers units set once at
+// startup, for instance) over to a reloaded program. The new program must be bound.
+static void CopyUniformValues(unsigned int from, const std::vector<UniformInfo>& uniforms, unsigned int to) {
+    float floats[16];
+    int ints[4];
+    for (const UniformInfo& uniform : uniforms) {
+        for (int i = 0; i < uniform.Size; i++) {
+            const std::string name = uniform.Size > 1 ? uniform.Name + "[" + std::to_string(i) + "]" : uniform.Name;
+            GLCall(const int source = glGetUniformLocation(from, name.c_str()));
+            GLCall(const int destination = glGetUniformLocation(to, name.c_str()));
+            if (source == -1 || destination == -1)
+                continue;
+
+            switch (uniform.Type) {
+                case GL_FLOAT:        GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniform1fv(destination, 1, floats)); break;
+                case GL_FLOAT_VEC2:   GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniform2fv(destination, 1, floats)); break;
+                case GL_FLOAT_VEC3:   GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniform3fv(destination, 1, floats)); break;
+                case GL_FLOAT_VEC4:   GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniform4fv(destination, 1, floats)); break;
+                case GL_FLOAT_MAT2:   GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniformMatrix2fv(destination, 1, GL_FALSE, floats)); break;
+                case GL_FLOAT_MAT3:   GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniformMatrix3fv(destination, 1, GL_FALSE, floats)); break;
+                case GL_FLOAT_MAT4:   GLCall(glGetUniformfv(from, source, floats)); GLCall(glUniformMatrix4fv(destination, 1, GL_FALSE, floats)); break;
+                case GL_INT_VEC2:
+                case GL_BOOL_VEC2:    GLCall(glGetUniformiv(from, source, ints)); GLCall(glUniform2iv(destination, 1, ints)); break;
+                case GL_INT_VEC3:
+                case GL_BOOL_VEC3:    GLCall(glGetUniformiv(from, source, ints)); GLCall(glUniform3iv(destination, 1, ints)); break;
+                case GL_INT_VEC4:
+                case GL_BOOL_VEC4:    GLCall(glGetUniformiv(from, source, ints)); GLCall(glUniform4iv(destination, 1, ints)); break;
+                default:
+                    if (IsIntUniformType(uniform.Type)) {
+                        GLCall(glGetUniformiv(from, source, ints));
+                        GLCall(glUniform1iv(destination, 1, ints));
+                    }
+            }
+        }
+    }
+}
 
 Shader::Shader(const std::string &filepath) : m_FilePath(filepath), m_RendererID(0) {
-    ShaderProgramSource source = ParseShader(filepath);
-    m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+    m_RendererID = CreateShader(ParseShader(filepath));
+    OnProgramLinked();
 }
 
 Shader::~Shader() {
-    GLCall(glDeleteProgram(m_RendererID))
+    Release();
+}
+
+Shader::Shader(Shader &&other) noexcept
+    : m_FilePath(std::move(other.m_FilePath)), m_RendererID(std::exchange(other.m_RendererID, 0)),
+      m_Uniforms(std::move(other.m_Uniforms)), m_UniformIndex(std::move(other.m_UniformIndex)),
+      m_HotReload(std::exchange(other.m_HotReload, false)), m_LastWriteTime(other.m_LastWriteTime),
+      m_LastPoll(other.m_LastPoll), m_Pending(std::exchange(other.m_Pending, {})), m_ReloadCount(other.m_ReloadCount) {
+}
+
+Shader &Shader::operator=(Shader &&other) noexcept {
+    if (this != &other) {
+        Release();
+        m_FilePath = std::move(other.m_FilePath);
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_Uniforms = std::move(other.m_Uniforms);
+        m_UniformIndex = std::move(other.m_UniformIndex);
+        m_HotReload = std::exchange(other.m_HotReload, false);
+        m_LastWriteTime = other.m_LastWriteTime;
+        m_LastPoll = other.m_LastPoll;
+        m_Pending = std::exchange(other.m_Pending, {});
+        m_ReloadCount = other.m_ReloadCount;
+    }
+    return *this;
+}
+
+void Shader::Release() {
+    if (m_Pending.Program) {
+        if (const unsigned int program = FinishCreateShader(m_Pending))
+            GLObjectPool::DestroyProgram(program);
+    }
+    GLObjectPool::DestroyProgram(m_RendererID);
+    m_RendererID = 0;
 }
 
 ShaderProgramSource Shader::ParseShader(const std::string& filepath) {
     std::ifstream stream(filepath);
+    if (!stream)
+        std::cout << "Failed to open shader '" << filepath << "'" << std::endl;
 
     enum class ShaderType {
-        NONE = -1, VERTEX = 0, FRAGMENT = 1
+        NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2
     };
 
     std::string line;
-    std::stringstream ss[2];
+    std::stringstream ss[3];
     ShaderType type = ShaderType::NONE;
     while (getline(stream, line)) {
         if (line.find("#shader") != std::string::npos) {
@@ -36,88 +270,329 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath) {
                 type = ShaderType::VERTEX;
             else if (line.find("fragment") != std::string::npos)
                 type = ShaderType::FRAGMENT;
-        } else {
+            else if (line.find("compute") != std::string::npos)
+                type = ShaderType::COMPUTE;
+        } else if (type != ShaderType::NONE) {
             ss[static_cast<int>(type)] << line << '\n';  // C++ cast
         }
     }
 
     return {
         ss[static_cast<int>(ShaderType::VERTEX)].str(),
-        ss[static_cast<int>(ShaderType::FRAGMENT)].str()
+        ss[static_cast<int>(ShaderType::FRAGMENT)].str(),
+        ss[static_cast<int>(ShaderType::COMPUTE)].str()
     };
 }
 
+// Only submits the source; the status is checked in FinishCreateShader so the
+// compile can run in the background
 unsigned int Shader::CompileShader(unsigned int type, const std::string& source) {
     unsigned int id = glCreateShader(type);
     const char* src = source.c_str();  // Get the pointer to the first element of the string
-    glShaderSource(id, 1, &src, nullptr);
-    glCompileShader(id);
+    GLCall(glShaderSource(id, 1, &src, nullptr));
+    GLCall(glCompileShader(id));
+    return id;
+}
 
-    int result;
-    glGetShaderiv(id, GL_COMPILE_STATUS, &result);
-    if (result == GL_FALSE) {
+unsigned int Shader::CreateShader(const ShaderProgramSource& source) {
+    const uint64_t key = GetCacheKey(source);
+    if (IsProgramBinarySupported()) {
+        if (const unsigned int program = LoadProgramBinary(key))
+            return program;
+    }
+
+    PendingProgram pending = BeginCreateShader(source);
+    pending.CacheKey = key;
+    return FinishCreateShader(pending);
+}
+
+PendingProgram Shader::BeginCreateShader(const ShaderProgramSource& source) {
+    IsParallelCompileSupported();
+
+    PendingProgram pending;
+    GLCall(pending.Program = glCreateProgram());
+    if (!source.ComputeSource.empty()) {
+        pending.ComputeShader = CompileShader(GL_COMPUTE_SHADER, source.ComputeSource);
+        GLCall(glAttachShader(pending.Program, pending.ComputeShader));
+    } else {
+        pending.VertexShader = CompileShader(GL_VERTEX_SHADER, source.VertexSource);
+        pending.FragmentShader = CompileShader(GL_FRAGMENT_SHADER, source.FragmentSource);
+        GLCall(glAttachShader(pending.Program, pending.VertexShader));
+        GLCall(glAttachShader(pending.Program, pending.FragmentShader));
+    }
+    if (IsProgramBinarySupported()) {
+        GLCall(glProgramParameteri(pending.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+    GLCall(glLinkProgram(pending.Program));
+    return pending;
+}
+
+// Blocks until the program is linked. Returns 0 (and deletes the program) when
+// compiling or linking failed, otherwise stores the binary in the cache.
+unsigned int Shader::FinishCreateShader(PendingProgram& pending) {
+    unsigned int program = pending.Program;
+    const std::pair<unsigned int, unsigned int> stages[] = {
+        { pending.VertexShader, GL_VERTEX_SHADER },
+        { pending.FragmentShader, GL_FRAGMENT_SHADER },
+        { pending.ComputeShader, GL_COMPUTE_SHADER }
+    };
+    bool compiled = true;
+    for (const auto& [shader, type] : stages) {
+        if (shader)
+            compiled = CheckCompileStatus(shader, type) && compiled;
+    }
+
+    int linked = GL_FALSE;
+    GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+    if (compiled && linked == GL_FALSE) {
         int length;
-        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-        // char* message = (char*)alloca(length * sizeof(char));  // C-style cast
-        char* message = static_cast<char*>(alloca(length * sizeof(char)));  // C++ cast
-        glGetShaderInfoLog(id, length, &length, message);
-        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" << std::endl;
+        GLCall(glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length));
+        std::string message(length, '\0');
+        GLCall(glGetProgramInfoLog(program, length, &length, message.data()));
+        std::cout << "Failed to link shader '" << m_FilePath << "'!" << std::endl;
         std::cout << message << std::endl;
-        glDeleteShader(id);
-        return 0;
     }
 
-    return id;
+    for (const auto& [shader, type] : stages) {
+        if (shader) {
+            GLCall(glDetachShader(program, shader));
+            GLCall(glDeleteShader(shader));
+        }
+    }
+
+    if (!compiled || linked == GL_FALSE) {
+        GLCall(glDeleteProgram(program));
+        program = 0;
+    } else if (IsProgramBinarySupported()) {
+        SaveProgramBinary(program, pending.CacheKey);
+    }
+
+    pending = {};
+    return program;
 }
 
-unsigned int Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader) {
-    GLCall(unsigned int program = glCreateProgram());
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+void Shader::SetHotReload(bool enabled) {
+    m_HotReload = enabled;
+    std::error_code error;
+    m_LastWriteTime = std::filesystem::last_write_time(m_FilePath, error);
+}
 
-    GLCall(glAttachShader(program, vs));
-    GLCall(glAttachShader(program, fs));
-    GLCall(glLinkProgram(program));
-    GLCall(glValidateProgram(program));
-    GLCall(glDeleteShader(vs));
-    GLCall(glDeleteShader(fs));
+bool Shader::CheckForReload() {
+    if (!m_HotReload)
+        return false;
 
-    return program;
+    if (m_Pending.Program) {
+        // Without the extension the status query below simply waits for the driver
+        if (IsParallelCompileSupported()) {
+            int completed = GL_FALSE;
+            GLCall(glGetProgramiv(m_Pending.Program, GL_COMPLETION_STATUS_KHR, &completed));
+            if (completed == GL_FALSE)
+                return false;
+        }
+
+        const unsigned int program = FinishCreateShader(m_Pending);
+        if (!program) {
+            std::cout << "Keeping the previous version of '" << m_FilePath << "'" << std::endl;
+            return false;
+        }
+        SwapProgram(program);
+        return true;
+    }
+
+    // Stat the file a few times per second rather than every frame
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_LastPoll < s_ReloadPollInterval)
+        return false;
+    m_LastPoll = now;
+
+    std::error_code error;
+    const auto writeTime = std::filesystem::last_write_time(m_FilePath, error);
+    if (error || writeTime == m_LastWriteTime)
+        return false;
+    m_LastWriteTime = writeTime;
+
+    const ShaderProgramSource source = ParseShader(m_FilePath);
+    const uint64_t key = GetCacheKey(source);
+    if (IsProgramBinarySupported()) {
+        // Reverting an edit hits the cache
+        if (const unsigned int program = LoadProgramBinary(key)) {
+            SwapProgram(program);
+            return true;
+        }
+    }
+
+    m_Pending = BeginCreateShader(source);
+    m_Pending.CacheKey = key;
+    return false;
+}
+
+void Shader::SwapProgram(unsigned int program) {
+    const unsigned int previous = m_RendererID;
+    const std::vector<UniformInfo> previousUniforms = std::move(m_Uniforms);
+
+    m_RendererID = program;
+    OnProgramLinked();
+    if (previous) {
+        GLStateCache::UseProgram(m_RendererID);
+        CopyUniformValues(previous, previousUniforms, m_RendererID);
+        // Frames already queued may still draw with it
+        GLObjectPool::DestroyProgram(previous);
+    }
+    m_ReloadCount++;
+}
+
+void Shader::OnProgramLinked() {
+    m_Uniforms.clear();
+    m_UniformIndex.clear();
+    if (!m_RendererID)
+        return;
+
+    IntrospectUniforms();
+    BindUniformBlock("Frame", FrameUniformBinding);
 }
 
 void Shader::Bind() const {
-    GLCall(glUseProgram(m_RendererID));
+    PROFILE_SCOPE("Shader::Bind");
+    GLStateCache::UseProgram(m_RendererID);
+}
 
+void Shader::Dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ) const {
+    Bind();
+    GLCall(glDispatchCompute(groupsX, groupsY, groupsZ));
 }
 
 void Shader::Unbind() const {
-    GLCall(glUseProgram(0));
+    GLStateCache::UseProgram(0);
 }
 
-void Shader::SetUniform1i(const std::string &name, int value) {
+void Shader::IntrospectUniforms() {
+    int count = 0;
+    int maxLength = 0;
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count));
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+
+    m_Uniforms.clear();
+    m_UniformIndex.clear();
+    m_Uniforms.reserve(count);
+
+    std::string name(maxLength, '\0');
+    for (int i = 0; i < count; i++) {
+        int length = 0;
+        int size = 0;
+        unsigned int type = 0;
+        GLCall(glGetActiveUniform(m_RendererID, i, maxLength, &length, &size, &type, name.data()));
+
+        UniformInfo info{ name.substr(0, length), -1, type, size };
+        // Uniforms inside blocks have no location
+        GLCall(info.Location = glGetUniformLocation(m_RendererID, info.Name.c_str()));
+        if (info.Location == -1)
+            continue;
+
+        // Arrays are reported as "name[0]"; they are looked up by their plain name
+        if (info.Name.ends_with("[0]"))
+            info.Name.resize(info.Name.size() - 3);
+
+        m_UniformIndex.emplace(info.Name, UniformSlot{ static_cast<int>(m_Uniforms.size()), info.Location });
+        m_Uniforms.push_back(std::move(info));
+    }
+}
+
+bool Shader::BindUniformBlock(std::string_view name, unsigned int binding) {
+    const std::string blockName(name);
+    GLCall(const unsigned int index = glGetUniformBlockIndex(m_RendererID, blockName.c_str()));
+    if (index == GL_INVALID_INDEX)
+        return false;
+
+    GLCall(glUniformBlockBinding(m_RendererID, index, binding));
+    return true;
+}
+
+void Shader::SetUniform(UniformHandle<int> handle, int value) {
+    GLCall(glUniform1i(handle.Location, value));
+}
+
+void Shader::SetUniform(UniformHandle<float> handle, float value) {
+    GLCall(glUniform1f(handle.Location, value));
+}
+
+void Shader::SetUniform(UniformHandle<glm::vec2> handle, const glm::vec2 &value) {
+    GLCall(glUniform2f(handle.Location, value.x, value.y));
+}
+
+void Shader::SetUniform(UniformHandle<glm::vec3> handle, const glm::vec3 &value) {
+    GLCall(glUniform3f(handle.Location, value.x, value.y, value.z));
+}
+
+void Shader::SetUniform(UniformHandle<glm::vec4> handle, const glm::vec4 &value) {
+    GLCall(glUniform4f(handle.Location, value.x, value.y, value.z, value.w));
+}
+
+void Shader::SetUniform(UniformHandle<glm::mat4> handle, const glm::mat4 &matrix) {
+    GLCall(glUniformMatrix4fv(handle.Location, 1, GL_FALSE, &matrix[0][0]));
+}
+
+void Shader::SetUniform1i(std::string_view name, int value) {
     GLCall(glUniform1i(GetUniformLocation(name), value));
 }
 
-void Shader::SetUniform1f(const std::string &name, float value) {
+void Shader::SetUniform1iv(std::string_view name, int count, const int *values) {
+    GLCall(glUniform1iv(GetUniformLocation(name), count, values));
+}
+
+void Shader::SetUniform1f(std::string_view name, float value) {
     GLCall(glUniform1f(GetUniformLocation(name), value));
 }
 
-void Shader::SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3) {
+void Shader::SetUniform4f(std::string_view name, float v0, float v1, float v2, float v3) {
     GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
 }
 
-void Shader::SetUniformMat4f(const std::string &name, const glm::mat4 &matrix) {
+void Shader::SetUniform4fv(std::string_view name, int count, const float *values) {
+    GLCall(glUniform4fv(GetUniformLocation(name), count, values));
+}
+
+void Shader::SetUniformMat4f(std::string_view name, const glm::mat4 &matrix) {
     GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
 }
 
-int Shader::GetUniformLocation(const std::string &name) {
-    if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
-        return m_UniformLocationCache[name];
+int Shader::GetUniformLocation(std::string_view name) {
+    const auto it = m_UniformIndex.find(name);
+    if (it != m_UniformIndex.end())
+        return it->second.Location;
 
-    GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
-    if (location == -1)
+    // Only whole uniforms were registered at link time; array elements are
+    // asked for once and cached under their array's entry. Misses are cached
+    // too, so the warning is only printed once.
+    const std::string key(name);
+    int location = -1;
+    if (m_RendererID) {
+        GLCall(location = glGetUniformLocation(m_RendererID, key.c_str()));
+    }
+    if (location == -1) {
         std::cout << "Warning: uniform '" << name << "' doesn't exist!" << std::endl;
+        m_UniformIndex.emplace(key, UniformSlot{ -1, -1 });
+        return -1;
+    }
 
-    m_UniformLocationCache[name] = location;
+    const auto array = m_UniformIndex.find(name.substr(0, name.find('[')));
+    m_UniformIndex.emplace(key, UniformSlot{ array != m_UniformIndex.end() ? array->second.Uniform : -1, location });
     return location;
 }
+
+bool Shader::CheckUniformType(std::string_view name, unsigned int expectedType) const {
+    // Elements of arrays of structs have no entry of their own to check against
+    const int uniform = m_UniformIndex.find(name)->second.Uniform;
+    if (uniform == -1)
+        return true;
+
+    const UniformInfo& info = m_Uniforms[uniform];
+    if (info.Type == expectedType)
+        return true;
+
+    // Samplers and bools are set through int handles
+    if (expectedType == GL_INT && IsIntUniformType(info.Type))
+        return true;
+
+    std::cout << "Warning: uniform '" << name << "' doesn't match the requested handle type!" << std::endl;
+    return false;
+}
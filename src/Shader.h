@@ -4,36 +4,151 @@
 
 #pragma once
 
+#include <chrono>
+#include <filesystem>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+#include <GL/glew.h>
 #include <glm/glm.hpp>
 
+#include "StringHash.h"
+
+// A file holds either a vertex and a fragment stage or a single compute stage
 struct ShaderProgramSource {
     std::string VertexSource;
     std::string FragmentSource;
+    std::string ComputeSource;
+};
+
+// An active uniform as reported by the linked program
+struct UniformInfo {
+    std::string Name;
+    int Location;
+    unsigned int Type;
+    int Size;
+};
+
+// Location resolved once, so setting the value needs no lookup at all.
+// T is the C++ type the uniform is set with.
+template<typename T>
+struct UniformHandle {
+    int Location = -1;
+
+    inline bool IsValid() const { return Location != -1; }
+};
+
+// A program whose shaders have been submitted for compiling and linking but
+// whose status hasn't been queried yet, so the driver can finish it off-thread
+struct PendingProgram {
+    unsigned int Program = 0;
+    unsigned int VertexShader = 0;
+    unsigned int FragmentShader = 0;
+    unsigned int ComputeShader = 0;
+    uint64_t CacheKey = 0;
 };
 
 class Shader {
 private:
+    // Uniform is the index into m_Uniforms, or -1 for names that were looked
+    // up and don't exist. Array elements like "u_Planes[2]" share their
+    // array's entry but have their own location.
+    struct UniformSlot {
+        int Uniform;
+        int Location;
+    };
+
     std::string m_FilePath;
     unsigned int m_RendererID{};
-    std::unordered_map<std::string, int> m_UniformLocationCache;
+    std::vector<UniformInfo> m_Uniforms;
+    std::unordered_map<std::string, UniformSlot, StringHash, std::equal_to<>> m_UniformIndex;
+
+    // Hot reload
+    bool m_HotReload = false;
+    std::filesystem::file_time_type m_LastWriteTime{};
+    std::chrono::steady_clock::time_point m_LastPoll{};
+    PendingProgram m_Pending;
+    unsigned int m_ReloadCount = 0;
 public:
     Shader(const std::string& filepath);
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+    Shader(Shader&& other) noexcept;
+    Shader& operator=(Shader&& other) noexcept;
+
     void Bind() const;
     void Unbind() const;
+    // Compute programs only (GL 4.3); binds the program and launches the groups
+    void Dispatch(unsigned int groupsX, unsigned int groupsY = 1, unsigned int groupsZ = 1) const;
+
+    // Watches the source file for edits. Changes are picked up by CheckForReload().
+    void SetHotReload(bool enabled);
+    // Call once per frame. Starts a rebuild when the file changed and swaps the
+    // new program in once it linked; a program that fails to build is dropped
+    // and the old one stays. Returns true when a new program was swapped in,
+    // after which uniform handles must be fetched again.
+    bool CheckForReload();
+    inline unsigned int GetReloadCount() const { return m_ReloadCount; }
+    inline bool IsValid() const { return m_RendererID != 0; }
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+
+    template<typename T>
+    UniformHandle<T> GetUniformHandle(std::string_view name);
+
+    // Points the named uniform block at a UniformBuffer binding. A block called
+    // "Frame" is bound to FrameUniformBinding automatically at link time.
+    bool BindUniformBlock(std::string_view name, unsigned int binding);
 
     //Set uniforms
-    void SetUniform1i(const std::string& name, int value);
-    void SetUniform1f(const std::string& name, float value);
-    void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
-    void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
+    void SetUniform(UniformHandle<int> handle, int value);
+    void SetUniform(UniformHandle<float> handle, float value);
+    void SetUniform(UniformHandle<glm::vec2> handle, const glm::vec2& value);
+    void SetUniform(UniformHandle<glm::vec3> handle, const glm::vec3& value);
+    void SetUniform(UniformHandle<glm::vec4> handle, const glm::vec4& value);
+    void SetUniform(UniformHandle<glm::mat4> handle, const glm::mat4& matrix);
+
+    void SetUniform1i(std::string_view name, int value);
+    void SetUniform1iv(std::string_view name, int count, const int* values);
+    void SetUniform1f(std::string_view name, float value);
+    void SetUniform4f(std::string_view name, float v0, float v1, float v2, float v3);
+    void SetUniform4fv(std::string_view name, int count, const float* values);
+    void SetUniformMat4f(std::string_view name, const glm::mat4& matrix);
+
+    inline const std::vector<UniformInfo>& GetUniforms() const { return m_Uniforms; }
 
 private:
     ShaderProgramSource ParseShader(const std::string& filepath);
     unsigned int CompileShader(unsigned int type, const std::string& source);
-    unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
-    int GetUniformLocation(const std::string& name);
-};
\ No newline at end of file
+    unsigned int CreateShader(const ShaderProgramSource& source);
+    PendingProgram BeginCreateShader(const ShaderProgramSource& source);
+    unsigned int FinishCreateShader(PendingProgram& pending);
+    void SwapProgram(unsigned int program);
+    void Release();
+    void OnProgramLinked();
+    void IntrospectUniforms();
+    int GetUniformLocation(std::string_view name);
+    bool CheckUniformType(std::string_view name, unsigned int expectedType) const;
+};
+
+template<typename T>
+struct UniformGLType {
+    static_assert(sizeof(T) == 0, "Unsupported uniform type in Shader::GetUniformHandle");
+};
+
+template<> struct UniformGLType<int> { static constexpr unsigned int Value = GL_INT; };
+template<> struct UniformGLType<float> { static constexpr unsigned int Value = GL_FLOAT; };
+template<> struct UniformGLType<glm::vec2> { static constexpr unsigned int Value = GL_FLOAT_VEC2; };
+template<> struct UniformGLType<glm::vec3> { static constexpr unsigned int Value = GL_FLOAT_VEC3; };
+template<> struct UniformGLType<glm::vec4> { static constexpr unsigned int Value = GL_FLOAT_VEC4; };
+template<> struct UniformGLType<glm::mat4> { static constexpr unsigned int Value = GL_FLOAT_MAT4; };
+
+template<typename T>
+UniformHandle<T> Shader::GetUniformHandle(std::string_view name) {
+    const int location = GetUniformLocation(name);
+    if (location != -1 && !CheckUniformType(name, UniformGLType<T>::Value))
+        return {};
+    return { location };
+}
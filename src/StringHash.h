@@ -0,0 +1,28 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Transparent hash so std::string keyed maps can be searched with a
+// string_view (or a literal) without building a temporary std::string
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+};
+
+// 64-bit FNV-1a. Unlike std::hash the result is stable between runs and
+// builds, so it can be used to name files on disk. Pass the previous result
+// as the seed to hash several strings together.
+constexpr uint64_t HashFNV1a(std::string_view value, uint64_t seed = 0xcbf29ce484222325ull) {
+    uint64_t hash = seed;
+    for (const char c : value) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
@@ -0,0 +1,123 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "TextObject.h"
+
+#include <algorithm>
+
+#include "Font.h"
+#include "Profiler.h"
+
+// Returns the codepoint at index and moves past it; bytes that don't form
+// valid UTF-8 are passed through one at a time
+static uint32_t DecodeUtf8(std::string_view text, size_t& index) {
+    const auto lead = static_cast<unsigned char>(text[index++]);
+    int extra = 0;
+    uint32_t codepoint = lead;
+    if ((lead & 0xE0) == 0xC0) { extra = 1; codepoint = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { extra = 2; codepoint = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { extra = 3; codepoint = lead & 0x07; }
+
+    if (index + extra > text.size())
+        return lead;
+    for (int i = 0; i < extra; i++) {
+        const auto next = static_cast<unsigned char>(text[index + i]);
+        if ((next & 0xC0) != 0x80)
+            return lead;
+        codepoint = codepoint << 6 | (next & 0x3F);
+    }
+    index += extra;
+    return codepoint;
+}
+
+TextObject::TextObject(Font &font, std::string_view text, const glm::vec3 &position, float size, const glm::vec4 &color)
+    : m_Font(font), m_Text(text), m_Position(position), m_Size(size), m_Color(color) {
+}
+
+void TextObject::SetText(std::string_view text) {
+    if (text == m_Text)
+        return;
+    m_Text = text;
+    m_Dirty = true;
+}
+
+void TextObject::SetPosition(const glm::vec3 &position) {
+    const glm::vec3 delta = position - m_Position;
+    m_Position = position;
+    if (m_Dirty)
+        return;
+    for (QuadVertex& vertex : m_Vertices)
+        vertex.Position += delta;
+}
+
+void TextObject::SetSize(float size) {
+    if (size == m_Size)
+        return;
+    m_Size = size;
+    m_Dirty = true;
+}
+
+void TextObject::SetColor(const glm::vec4 &color) {
+    m_Color = color;
+    if (m_Dirty)
+        return;
+    for (QuadVertex& vertex : m_Vertices)
+        vertex.Color = color;
+}
+
+const std::vector<QuadVertex>& TextObject::GetVertices() {
+    if (m_Dirty)
+        Rebuild();
+    return m_Vertices;
+}
+
+glm::vec2 TextObject::GetExtent() {
+    if (m_Dirty)
+        Rebuild();
+    return m_Extent;
+}
+
+void TextObject::Rebuild() {
+    PROFILE_SCOPE("TextObject::Rebuild");
+    m_Dirty = false;
+    m_Rebuilds++;
+    m_Vertices.clear();
+    if (!m_Font.IsValid()) {
+        m_Extent = glm::vec2(0.0f);
+        return;
+    }
+
+    const float scale = m_Size / m_Font.GetPixelHeight();
+    const float lineHeight = m_Font.GetLineHeight() * scale;
+    glm::vec2 pen(0.0f);
+    float width = 0.0f;
+    const Glyph* previous = nullptr;
+    for (size_t i = 0; i < m_Text.size();) {
+        const uint32_t codepoint = DecodeUtf8(m_Text, i);
+        if (codepoint == '\n') {
+            width = std::max(width, pen.x);
+            pen = { 0.0f, pen.y - lineHeight };
+            previous = nullptr;
+            continue;
+        }
+
+        const Glyph& glyph = m_Font.GetGlyph(codepoint);
+        if (previous)
+            pen.x += m_Font.GetKerning(*previous, glyph) * scale;
+        previous = &glyph;
+
+        if (glyph.Size.x > 0.0f) {
+            const glm::vec2 min = pen + glyph.Offset * scale;
+            const glm::vec2 max = min + glyph.Size * scale;
+            const glm::vec2 corners[4] = { min, { max.x, min.y }, max, { min.x, max.y } };
+            const glm::vec2 uvs[4] = { glyph.UVMin, { glyph.UVMax.x, glyph.UVMin.y }, glyph.UVMax, { glyph.UVMin.x, glyph.UVMax.y } };
+            for (int corner = 0; corner < 4; corner++)
+                m_Vertices.push_back({ m_Position + glm::vec3(corners[corner], 0.0f), m_Color, uvs[corner], 0.0f });
+        }
+        pen.x += glyph.Advance * scale;
+    }
+
+    width = std::max(width, pen.x);
+    m_Extent = { width, -pen.y + lineHeight };
+}
@@ -0,0 +1,52 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BatchRenderer.h"
+
+class Font;
+
+// A string laid out once into batch quads and kept until it changes, so
+// static labels cost a copy per frame instead of a layout. Setting the same
+// text again is free; moving or recoloring patches the quads in place.
+class TextObject {
+private:
+    Font& m_Font;
+    std::string m_Text;
+    glm::vec3 m_Position;  // Baseline origin of the first line
+    float m_Size;          // Pixel height the text is drawn at
+    glm::vec4 m_Color;
+    std::vector<QuadVertex> m_Vertices;
+    glm::vec2 m_Extent{ 0.0f };
+    bool m_Dirty = true;
+    unsigned int m_Rebuilds = 0;
+public:
+    explicit TextObject(Font& font, std::string_view text = {}, const glm::vec3& position = glm::vec3(0.0f),
+                        float size = 32.0f, const glm::vec4& color = glm::vec4(1.0f));
+
+    // UTF-8; '\n' starts a new line
+    void SetText(std::string_view text);
+    void SetPosition(const glm::vec3& position);
+    void SetSize(float size);
+    void SetColor(const glm::vec4& color);
+
+    inline const std::string& GetText() const { return m_Text; }
+    inline const glm::vec3& GetPosition() const { return m_Position; }
+    inline Font& GetFont() const { return m_Font; }
+    inline unsigned int GetRebuildCount() const { return m_Rebuilds; }
+
+    // Quads in world space, four vertices each, laid out again first if needed
+    const std::vector<QuadVertex>& GetVertices();
+    // Width of the longest line and height of all lines
+    glm::vec2 GetExtent();
+
+private:
+    void Rebuild();
+};
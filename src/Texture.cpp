@@ -4,38 +4,206 @@
 
 #include "Texture.h"
 
+#include <filesystem>
+#include <utility>
+
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
+#include "Profiler.h"
 #include "stb_image/stb_image.h"
 
-Texture::Texture(const std::string &path)
-    : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0) {
+static bool IsMipmapFilter(unsigned int filter) {
+    return filter != GL_LINEAR && filter != GL_NEAREST;
+}
+
+static unsigned int GetCompressedFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        default: ;
+    }
+    return 0;
+}
+
+Texture::Texture(const std::string &path, const TextureSpecification &specification)
+    : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0),
+      m_Specification(specification) {
+
+    // Compressed formats can't be mipmapped by the driver, and fall back to
+    // RGBA8 where S3TC is missing
+    if (m_Specification.Format != TextureFormat::RGBA8 && !GLEW_EXT_texture_compression_s3tc)
+        m_Specification.Format = TextureFormat::RGBA8;
+    if (m_Specification.Format != TextureFormat::RGBA8 && m_Specification.Mipmaps == MipmapMode::GPU)
+        m_Specification.Mipmaps = MipmapMode::CPU;
+
+    const std::string cachePath = GetCachePath(path, m_Specification);
+    if (m_Specification.UseCache) {
+        // A missing source or cache fails its own call, so each is checked
+        std::error_code sourceError;
+        std::error_code cacheError;
+        const auto sourceTime = std::filesystem::last_write_time(path, sourceError);
+        const auto cacheTime = std::filesystem::last_write_time(cachePath, cacheError);
+        if (!sourceError && !cacheError && cacheTime >= sourceTime) {
+            const TextureData cached = TextureData::Load(cachePath);
+            if (cached.IsValid()) {
+                m_BPP = 4;
+                m_RendererID = GLObjectPool::CreateTexture();
+                SetData(cached);
+                return;
+            }
+        }
+    }
 
     stbi_set_flip_vertically_on_load(1);
     m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
-    GLCall(glGenTextures(1, &m_RendererID));
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
 
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    if (m_LocalBuffer && (m_Specification.Mipmaps == MipmapMode::CPU || m_Specification.Format != TextureFormat::RGBA8 || m_Specification.UseCache)) {
+        TextureData data = TextureData::FromPixels(m_Width, m_Height, m_LocalBuffer, m_Specification.Mipmaps != MipmapMode::None);
+        if (m_Specification.Format != TextureFormat::RGBA8)
+            data = data.Compress(m_Specification.Format);
 
-    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+        m_RendererID = GLObjectPool::CreateTexture();
+        SetData(data);
+
+        if (m_Specification.UseCache) {
+            std::error_code error;
+            std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), error);
+            data.Save(cachePath);
+        }
+    } else {
+        Create(m_LocalBuffer);
+    }
 
     if (m_LocalBuffer) {
         stbi_image_free(m_LocalBuffer);
+        m_LocalBuffer = nullptr;
     }
 }
 
+Texture::Texture(int width, int height, const unsigned char *data)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(width), m_Height(height), m_BPP(4) {
+    Create(data);
+}
+
+Texture::Texture(const TextureData &data, const TextureSpecification &specification)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(4), m_Specification(specification) {
+    m_RendererID = GLObjectPool::CreateTexture();
+    SetData(data);
+}
+
 Texture::~Texture() {
-    GLCall(glDeleteTextures(1, &m_RendererID));
+    GLObjectPool::DestroyTexture(m_RendererID);
+}
+
+Texture::Texture(Texture &&other) noexcept
+    : m_RendererID(std::exchange(other.m_RendererID, 0)), m_FilePath(std::move(other.m_FilePath)),
+      m_LocalBuffer(std::exchange(other.m_LocalBuffer, nullptr)), m_Width(other.m_Width), m_Height(other.m_Height),
+      m_BPP(other.m_BPP), m_Specification(other.m_Specification) {
+}
+
+Texture &Texture::operator=(Texture &&other) noexcept {
+    if (this != &other) {
+        GLObjectPool::DestroyTexture(m_RendererID);
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_FilePath = std::move(other.m_FilePath);
+        m_LocalBuffer = std::exchange(other.m_LocalBuffer, nullptr);
+        m_Width = other.m_Width;
+        m_Height = other.m_Height;
+        m_BPP = other.m_BPP;
+        m_Specification = other.m_Specification;
+    }
+    return *this;
+}
+
+void Texture::Create(const unsigned char *data) {
+    m_RendererID = GLObjectPool::CreateTexture();
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data));
+    if (m_Specification.Mipmaps == MipmapMode::GPU) {
+        GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+    }
+    ApplySampler(m_Specification.Mipmaps != MipmapMode::None);
+
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
+}
+
+void Texture::ApplySampler(bool hasMipmaps) const {
+    unsigned int minFilter = m_Specification.MinFilter;
+    if (hasMipmaps && !IsMipmapFilter(minFilter))
+        minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    else if (!hasMipmaps && IsMipmapFilter(minFilter))
+        minFilter = GL_LINEAR;
+
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_Specification.MagFilter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_Specification.Wrap));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_Specification.Wrap));
+}
+
+void Texture::SetData(int width, int height, const void *data) {
+    PROFILE_GPU_SCOPE("Texture::SetData");
+    m_Width = width;
+    m_Height = height;
+
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data));
+    if (m_Specification.Mipmaps == MipmapMode::GPU) {
+        GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+    }
+}
+
+void Texture::SetData(const TextureData &data) {
+    PROFILE_GPU_SCOPE("Texture::SetData");
+    const std::vector<TextureLevel>& levels = data.GetLevels();
+    m_Width = levels[0].Width;
+    m_Height = levels[0].Height;
+
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+
+    const unsigned int compressedFormat = GetCompressedFormat(data.GetFormat());
+    for (unsigned int i = 0; i < levels.size(); i++) {
+        const TextureLevel& level = levels[i];
+        if (compressedFormat) {
+            GLCall(glCompressedTexImage2D(GL_TEXTURE_2D, i, compressedFormat, level.Width, level.Height, 0, level.Size, level.Data));
+        } else {
+            GLCall(glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, level.Width, level.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.Data));
+        }
+    }
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<int>(levels.size()) - 1));
+
+    bool hasMipmaps = levels.size() > 1;
+    if (!hasMipmaps && m_Specification.Mipmaps == MipmapMode::GPU && !compressedFormat) {
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000));
+        GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+        hasMipmaps = true;
+    }
+    ApplySampler(hasMipmaps);
+}
+
+void Texture::SetSubData(int x, int y, int width, int height, const void *data) {
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+    GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data));
 }
 
 void Texture::Bind(const unsigned int slot) const {
-    GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
 }
 
-void Texture::Unbind() const {
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+void Texture::Unbind(const unsigned int slot) const {
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, 0);
+}
+
+std::string Texture::GetCachePath(const std::string &path, const TextureSpecification &specification) {
+    static constexpr const char* formatNames[] = { "rgba8", "bc1", "bc3" };
+
+    std::string name = path;
+    for (char& c : name) {
+        if (c == '/' || c == '\\' || c == ':')
+            c = '_';
+    }
+
+    const bool mipmapped = specification.Mipmaps != MipmapMode::None;
+    return "cache/textures/" + name + "." + formatNames[static_cast<unsigned int>(specification.Format)]
+           + (mipmapped ? ".mip" : "") + ".mogt";
 }
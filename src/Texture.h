@@ -5,6 +5,25 @@
 #pragma once
 
 #include "Renderer.h"
+#include "TextureData.h"
+
+enum class MipmapMode {
+    None,
+    GPU, // glGenerateMipmap after upload
+    CPU  // box-filtered chain built before upload, required for compressed formats
+};
+
+struct TextureSpecification {
+    // A non-mipmapped MinFilter is promoted to GL_LINEAR_MIPMAP_LINEAR when mipmaps are enabled
+    unsigned int MinFilter = GL_LINEAR;
+    unsigned int MagFilter = GL_LINEAR;
+    unsigned int Wrap = GL_CLAMP_TO_EDGE;
+    MipmapMode Mipmaps = MipmapMode::None;
+    TextureFormat Format = TextureFormat::RGBA8;
+    // Keep the decoded (and compressed) mip chain in cache/textures, so later
+    // runs map it and upload it without decoding the image again
+    bool UseCache = false;
+};
 
 class Texture {
 private:
@@ -12,14 +31,39 @@ private:
     std::string m_FilePath;
     unsigned char* m_LocalBuffer;
     int m_Width, m_Height, m_BPP;
+    TextureSpecification m_Specification;
 public:
-    explicit Texture(const std::string& path);
+    explicit Texture(const std::string& path, const TextureSpecification& specification = TextureSpecification());
+    // RGBA8 texture created from raw pixel data (e.g. a 1x1 white texture)
+    Texture(int width, int height, const unsigned char* data);
+    explicit Texture(const TextureData& data, const TextureSpecification& specification = TextureSpecification());
     ~Texture();
 
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+    Texture(Texture&& other) noexcept;
+    Texture& operator=(Texture&& other) noexcept;
+
+    // Replaces the whole image with RGBA8 pixels. With a GL_PIXEL_UNPACK_BUFFER
+    // bound, data is an offset into that buffer instead of a pointer.
+    void SetData(int width, int height, const void* data);
+    // Replaces the whole image, including every mip level in data
+    void SetData(const TextureData& data);
+    // Overwrites a region of level 0 with tightly packed RGBA8 rows
+    void SetSubData(int x, int y, int width, int height, const void* data);
+
     void Bind(unsigned int slot = 0) const;
-    void Unbind() const;
+    void Unbind(unsigned int slot = 0) const;
 
+    // False when the image failed to load
+    inline bool IsValid() const { return m_RendererID != 0 && m_Width > 0 && m_Height > 0; }
     inline int GetWidth() const { return m_Width; }
     inline int GetHeight() const { return m_Height; }
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+
+    static std::string GetCachePath(const std::string& path, const TextureSpecification& specification);
 
-};
\ No newline at end of file
+private:
+    void Create(const unsigned char* data);
+    void ApplySampler(bool hasMipmaps) const;
+};
@@ -0,0 +1,256 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "TextureAtlas.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "GLStateCache.h"
+#include "stb_image/stb_image.h"
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/stb_rect_pack.h"
+
+static constexpr char s_AtlasMagic[4] = { 'M', 'O', 'G', 'A' };
+static constexpr unsigned int s_AtlasVersion = 1;
+
+const AtlasRegion* TextureAtlas::Find(std::string_view name) const {
+    const auto it = m_Regions.find(name);
+    return it != m_Regions.end() ? &it->second : nullptr;
+}
+
+template<typename T>
+static void WriteValue(std::ofstream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool ReadValue(std::ifstream& stream, T& value) {
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool TextureAtlas::Save(const std::string &path) const {
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+        return false;
+
+    stream.write(s_AtlasMagic, sizeof(s_AtlasMagic));
+    WriteValue(stream, s_AtlasVersion);
+    WriteValue(stream, static_cast<unsigned int>(m_Pages.size()));
+    WriteValue(stream, static_cast<unsigned int>(m_Regions.size()));
+
+    for (const auto& [name, region] : m_Regions) {
+        WriteValue(stream, static_cast<unsigned int>(name.size()));
+        stream.write(name.data(), static_cast<std::streamsize>(name.size()));
+        WriteValue(stream, region);
+    }
+
+    // The pixels only live on the GPU, so read each page back
+    std::vector<unsigned char> pixels;
+    int previousAlignment = 4;
+    GLCall(glGetIntegerv(GL_PACK_ALIGNMENT, &previousAlignment));
+    GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+    for (const auto& page : m_Pages) {
+        const int width = page->GetWidth();
+        const int height = page->GetHeight();
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+
+        page->Bind();
+        GLCall(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+
+        WriteValue(stream, width);
+        WriteValue(stream, height);
+        stream.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+    }
+    GLCall(glPixelStorei(GL_PACK_ALIGNMENT, previousAlignment));
+
+    return static_cast<bool>(stream);
+}
+
+std::unique_ptr<TextureAtlas> TextureAtlas::Load(const std::string &path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        return nullptr;
+
+    char magic[4];
+    unsigned int version, pageCount, regionCount;
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, s_AtlasMagic, sizeof(magic)) != 0)
+        return nullptr;
+    if (!ReadValue(stream, version) || version != s_AtlasVersion)
+        return nullptr;
+    if (!ReadValue(stream, pageCount) || !ReadValue(stream, regionCount))
+        return nullptr;
+
+    auto atlas = std::make_unique<TextureAtlas>();
+    std::string name;
+    for (unsigned int i = 0; i < regionCount; i++) {
+        unsigned int length;
+        AtlasRegion region{};
+        if (!ReadValue(stream, length))
+            return nullptr;
+        name.resize(length);
+        if (!stream.read(name.data(), length) || !ReadValue(stream, region))
+            return nullptr;
+        atlas->m_Regions.emplace(name, region);
+    }
+
+    std::vector<unsigned char> pixels;
+    for (unsigned int i = 0; i < pageCount; i++) {
+        int width, height;
+        if (!ReadValue(stream, width) || !ReadValue(stream, height))
+            return nullptr;
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+        if (!stream.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size())))
+            return nullptr;
+        atlas->m_Pages.push_back(std::make_unique<Texture>(width, height, pixels.data()));
+    }
+
+    return atlas;
+}
+
+std::unique_ptr<TextureAtlas> TextureAtlas::LoadOrBuild(const std::vector<std::string> &files, const std::string &cachePath,
+                                                        int pageSize, int padding) {
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    const auto cacheTime = fs::last_write_time(cachePath, error);
+    if (!error) {
+        bool upToDate = true;
+        for (const std::string& file : files) {
+            const auto fileTime = fs::last_write_time(file, error);
+            if (error || fileTime > cacheTime) {
+                upToDate = false;
+                break;
+            }
+        }
+
+        if (upToDate) {
+            std::unique_ptr<TextureAtlas> atlas = Load(cachePath);
+            bool complete = atlas != nullptr;
+            for (size_t i = 0; complete && i < files.size(); i++)
+                complete = atlas->Find(files[i]) != nullptr;
+            if (complete)
+                return atlas;
+        }
+    }
+
+    TextureAtlasBuilder builder(pageSize, padding);
+    for (const std::string& file : files)
+        builder.AddFile(file);
+
+    std::unique_ptr<TextureAtlas> atlas = builder.Build();
+    if (!atlas->Save(cachePath))
+        std::cout << "Warning: could not write texture atlas cache '" << cachePath << "'" << std::endl;
+    return atlas;
+}
+
+TextureAtlasBuilder::TextureAtlasBuilder(int pageSize, int padding)
+    : m_PageSize(pageSize), m_Padding(padding) {
+}
+
+void TextureAtlasBuilder::Add(const std::string &name, int width, int height, const unsigned char *pixels) {
+    Image image{ name, width, height, {} };
+    image.Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+    m_Images.push_back(std::move(image));
+}
+
+bool TextureAtlasBuilder::AddFile(const std::string &path) {
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    int width, height, channels;
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cout << "Failed to load texture '" << path << "': " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+
+    Add(path, width, height, pixels);
+    stbi_image_free(pixels);
+    return true;
+}
+
+// Repeats the outermost texels of the image at (x, y) into its padding, so
+// filtering and mipmaps at the region's edge pick up the image, not its
+// neighbours or transparent black
+void TextureAtlasBuilder::ExtrudeEdges(std::vector<unsigned char>& pixels, int x, int y, int width, int height) const {
+    const auto texel = [&](int column, int row) { return &pixels[(static_cast<size_t>(row) * m_PageSize + column) * 4]; };
+    for (int row = y; row < y + height; row++) {
+        for (int pad = 1; pad <= m_Padding; pad++) {
+            std::memcpy(texel(x - pad, row), texel(x, row), 4);
+            std::memcpy(texel(x + width - 1 + pad, row), texel(x + width - 1, row), 4);
+        }
+    }
+    // Whole padded rows, so the corners get the corner texels
+    const size_t rowSize = static_cast<size_t>(width + m_Padding * 2) * 4;
+    for (int pad = 1; pad <= m_Padding; pad++) {
+        std::memcpy(texel(x - m_Padding, y - pad), texel(x - m_Padding, y), rowSize);
+        std::memcpy(texel(x - m_Padding, y + height - 1 + pad), texel(x - m_Padding, y + height - 1), rowSize);
+    }
+}
+
+std::unique_ptr<TextureAtlas> TextureAtlasBuilder::Build() {
+    auto atlas = std::make_unique<TextureAtlas>();
+
+    std::vector<stbrp_rect> pending;
+    pending.reserve(m_Images.size());
+    for (int i = 0; i < static_cast<int>(m_Images.size()); i++) {
+        const Image& image = m_Images[i];
+        if (image.Width + m_Padding * 2 > m_PageSize || image.Height + m_Padding * 2 > m_PageSize) {
+            std::cout << "Warning: '" << image.Name << "' does not fit in a " << m_PageSize << " atlas page" << std::endl;
+            continue;
+        }
+        stbrp_rect rect{};
+        rect.id = i;
+        rect.w = static_cast<stbrp_coord>(image.Width + m_Padding * 2);
+        rect.h = static_cast<stbrp_coord>(image.Height + m_Padding * 2);
+        pending.push_back(rect);
+    }
+
+    std::vector<stbrp_node> nodes(m_PageSize);
+    std::vector<unsigned char> pagePixels(static_cast<size_t>(m_PageSize) * m_PageSize * 4);
+    const float texel = 1.0f / static_cast<float>(m_PageSize);
+
+    // Fill one page at a time; whatever does not fit carries over to the next
+    while (!pending.empty()) {
+        const auto page = static_cast<unsigned int>(atlas->m_Pages.size());
+
+        stbrp_context context;
+        stbrp_init_target(&context, m_PageSize, m_PageSize, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, pending.data(), static_cast<int>(pending.size()));
+
+        std::fill(pagePixels.begin(), pagePixels.end(), 0);
+        std::vector<stbrp_rect> leftover;
+        for (const stbrp_rect& rect : pending) {
+            if (!rect.was_packed) {
+                leftover.push_back(rect);
+                continue;
+            }
+
+            const Image& image = m_Images[rect.id];
+            const int x = rect.x + m_Padding;
+            const int y = rect.y + m_Padding;
+            for (int row = 0; row < image.Height; row++) {
+                std::memcpy(&pagePixels[(static_cast<size_t>(y + row) * m_PageSize + x) * 4],
+                            &image.Pixels[static_cast<size_t>(row) * image.Width * 4],
+                            static_cast<size_t>(image.Width) * 4);
+            }
+            ExtrudeEdges(pagePixels, x, y, image.Width, image.Height);
+
+            AtlasRegion region{ page, x, y, image.Width, image.Height,
+                                glm::vec2(x, y) * texel,
+                                glm::vec2(x + image.Width, y + image.Height) * texel };
+            atlas->m_Regions.emplace(image.Name, region);
+        }
+
+        atlas->m_Pages.push_back(std::make_unique<Texture>(m_PageSize, m_PageSize, pagePixels.data()));
+        pending = std::move(leftover);
+    }
+
+    m_Images.clear();
+    return atlas;
+}
@@ -0,0 +1,76 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Texture.h"
+#include "StringHash.h"
+
+// Where one source image ended up inside an atlas
+struct AtlasRegion {
+    unsigned int Page;
+    int X, Y, Width, Height;
+    glm::vec2 UVMin;
+    glm::vec2 UVMax;
+};
+
+// One or more large textures holding many small images, so sprites drawn from
+// different source images can share a texture slot and a batch
+class TextureAtlas {
+private:
+    std::vector<std::unique_ptr<Texture>> m_Pages;
+    std::unordered_map<std::string, AtlasRegion, StringHash, std::equal_to<>> m_Regions;
+
+    friend class TextureAtlasBuilder;
+
+public:
+    const AtlasRegion* Find(std::string_view name) const;
+
+    inline const Texture& GetPage(unsigned int page) const { return *m_Pages[page]; }
+    inline unsigned int GetPageCount() const { return static_cast<unsigned int>(m_Pages.size()); }
+    inline unsigned int GetRegionCount() const { return static_cast<unsigned int>(m_Regions.size()); }
+
+    // Writes the packed pages and regions to a binary file, so later runs can
+    // skip decoding and packing the source images
+    bool Save(const std::string& path) const;
+    static std::unique_ptr<TextureAtlas> Load(const std::string& path);
+
+    // Loads cachePath if it is newer than every file and contains all of them,
+    // otherwise packs the files and rewrites the cache
+    static std::unique_ptr<TextureAtlas> LoadOrBuild(const std::vector<std::string>& files, const std::string& cachePath,
+                                                     int pageSize = 2048, int padding = 1);
+};
+
+class TextureAtlasBuilder {
+private:
+    struct Image {
+        std::string Name;
+        int Width, Height;
+        std::vector<unsigned char> Pixels;
+    };
+
+    std::vector<Image> m_Images;
+    int m_PageSize;
+    int m_Padding;
+
+public:
+    explicit TextureAtlasBuilder(int pageSize = 2048, int padding = 1);
+
+    // RGBA8 pixels, bottom row first like every other texture
+    void Add(const std::string& name, int width, int height, const unsigned char* pixels);
+    // Decodes an image file and adds it under its path
+    bool AddFile(const std::string& path);
+
+    std::unique_ptr<TextureAtlas> Build();
+
+private:
+    void ExtrudeEdges(std::vector<unsigned char>& pixels, int x, int y, int width, int height) const;
+};
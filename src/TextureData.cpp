@@ -0,0 +1,287 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "TextureData.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+static constexpr char s_CacheMagic[4] = { 'M', 'O', 'G', 'T' };
+static constexpr unsigned int s_CacheVersion = 1;
+
+struct CacheHeader {
+    char Magic[4];
+    unsigned int Version;
+    unsigned int Format;
+    unsigned int LevelCount;
+};
+
+struct CacheLevel {
+    int Width, Height;
+    unsigned int Offset;
+    unsigned int Size;
+};
+
+unsigned int TextureData::GetLevelSize(TextureFormat format, int width, int height) {
+    const unsigned int blocks = std::max(1, (width + 3) / 4) * std::max(1, (height + 3) / 4);
+    switch (format) {
+        case TextureFormat::BC1: return blocks * 8;
+        case TextureFormat::BC3: return blocks * 16;
+        default: ;
+    }
+    return width * height * 4;
+}
+
+// Averages each 2x2 block of the previous level; the last row or column of an
+// odd-sized level is folded into its neighbour
+static void Downsample(const unsigned char* source, int width, int height, unsigned char* destination) {
+    const int levelWidth = std::max(1, width / 2);
+    const int levelHeight = std::max(1, height / 2);
+
+    for (int y = 0; y < levelHeight; y++) {
+        const int y0 = std::min(y * 2, height - 1);
+        const int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < levelWidth; x++) {
+            const int x0 = std::min(x * 2, width - 1);
+            const int x1 = std::min(x * 2 + 1, width - 1);
+            for (int c = 0; c < 4; c++) {
+                const int sum = source[(y0 * width + x0) * 4 + c] + source[(y0 * width + x1) * 4 + c]
+                              + source[(y1 * width + x0) * 4 + c] + source[(y1 * width + x1) * 4 + c];
+                destination[(y * levelWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+TextureData TextureData::FromPixels(int width, int height, const unsigned char *pixels, bool generateMipmaps) {
+    TextureData data;
+
+    size_t total = static_cast<size_t>(width) * height * 4;
+    std::vector<std::pair<int, int>> sizes = { { width, height } };
+    while (generateMipmaps && (sizes.back().first > 1 || sizes.back().second > 1)) {
+        const int levelWidth = std::max(1, sizes.back().first / 2);
+        const int levelHeight = std::max(1, sizes.back().second / 2);
+        sizes.emplace_back(levelWidth, levelHeight);
+        total += static_cast<size_t>(levelWidth) * levelHeight * 4;
+    }
+
+    data.m_Storage.resize(total);
+    std::memcpy(data.m_Storage.data(), pixels, static_cast<size_t>(width) * height * 4);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        const auto [levelWidth, levelHeight] = sizes[i];
+        unsigned char* level = data.m_Storage.data() + offset;
+        if (i > 0)
+            Downsample(data.m_Levels.back().Data, sizes[i - 1].first, sizes[i - 1].second, level);
+
+        const unsigned int size = levelWidth * levelHeight * 4;
+        data.m_Levels.push_back({ levelWidth, levelHeight, level, size });
+        offset += size;
+    }
+
+    return data;
+}
+
+static unsigned short PackRGB565(const int* color) {
+    return static_cast<unsigned short>(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+}
+
+static void UnpackRGB565(unsigned short packed, int* color) {
+    const int r = packed >> 11 & 31, g = packed >> 5 & 63, b = packed & 31;
+    color[0] = r << 3 | r >> 2;
+    color[1] = g << 2 | g >> 4;
+    color[2] = b << 3 | b >> 2;
+}
+
+// Bounding-box endpoints inset by 1/16 of the range, then nearest palette
+// entry per texel. Always uses four-color mode.
+static void EncodeColorBlock(const unsigned char block[16][4], unsigned char* output) {
+    int minColor[3] = { 255, 255, 255 };
+    int maxColor[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            minColor[c] = std::min(minColor[c], static_cast<int>(block[i][c]));
+            maxColor[c] = std::max(maxColor[c], static_cast<int>(block[i][c]));
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        const int inset = (maxColor[c] - minColor[c]) / 16;
+        minColor[c] = std::min(255, minColor[c] + inset);
+        maxColor[c] = std::max(0, maxColor[c] - inset);
+    }
+
+    unsigned short color0 = PackRGB565(maxColor);
+    unsigned short color1 = PackRGB565(minColor);
+    if (color0 < color1)
+        std::swap(color0, color1);
+
+    int palette[4][3];
+    UnpackRGB565(color0, palette[0]);
+    UnpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    unsigned int indices = 0;
+    if (color0 != color1) {
+        for (int i = 0; i < 16; i++) {
+            int best = 0;
+            int bestDistance = 0x7fffffff;
+            for (int p = 0; p < 4; p++) {
+                int distance = 0;
+                for (int c = 0; c < 3; c++) {
+                    const int delta = block[i][c] - palette[p][c];
+                    distance += delta * delta;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<unsigned int>(best) << (i * 2);
+        }
+    }
+
+    output[0] = color0 & 0xff;
+    output[1] = color0 >> 8;
+    output[2] = color1 & 0xff;
+    output[3] = color1 >> 8;
+    std::memcpy(output + 4, &indices, 4);
+}
+
+// Eight-value mode: a0 > a1, six interpolated steps between them
+static void EncodeAlphaBlock(const unsigned char block[16][4], unsigned char* output) {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; i++) {
+        minAlpha = std::min(minAlpha, static_cast<int>(block[i][3]));
+        maxAlpha = std::max(maxAlpha, static_cast<int>(block[i][3]));
+    }
+
+    output[0] = static_cast<unsigned char>(maxAlpha);
+    output[1] = static_cast<unsigned char>(minAlpha);
+
+    int palette[8] = { maxAlpha, minAlpha };
+    for (int i = 2; i < 8; i++)
+        palette[i] = ((8 - i) * maxAlpha + (i - 1) * minAlpha) / 7;
+
+    unsigned long long indices = 0;
+    if (maxAlpha != minAlpha) {
+        for (int i = 0; i < 16; i++) {
+            int best = 0;
+            for (int p = 1; p < 8; p++) {
+                if (std::abs(block[i][3] - palette[p]) < std::abs(block[i][3] - palette[best]))
+                    best = p;
+            }
+            indices |= static_cast<unsigned long long>(best) << (i * 3);
+        }
+    }
+
+    for (int i = 0; i < 6; i++)
+        output[2 + i] = static_cast<unsigned char>(indices >> (i * 8) & 0xff);
+}
+
+TextureData TextureData::Compress(TextureFormat format) const {
+    // Only uncompressed data can be encoded
+    if (m_Format != TextureFormat::RGBA8 || m_Levels.empty())
+        return {};
+    if (format == TextureFormat::RGBA8)
+        return FromPixels(m_Levels[0].Width, m_Levels[0].Height, m_Levels[0].Data, m_Levels.size() > 1);
+
+    TextureData data;
+    data.m_Format = format;
+
+    size_t total = 0;
+    for (const TextureLevel& level : m_Levels)
+        total += GetLevelSize(format, level.Width, level.Height);
+    data.m_Storage.resize(total);
+
+    const unsigned int blockSize = format == TextureFormat::BC1 ? 8 : 16;
+    unsigned char* output = data.m_Storage.data();
+    for (const TextureLevel& level : m_Levels) {
+        const unsigned int size = GetLevelSize(format, level.Width, level.Height);
+        data.m_Levels.push_back({ level.Width, level.Height, output, size });
+
+        unsigned char block[16][4];
+        for (int by = 0; by < level.Height; by += 4) {
+            for (int bx = 0; bx < level.Width; bx += 4) {
+                // Edge blocks repeat the last row and column
+                for (int i = 0; i < 16; i++) {
+                    const int x = std::min(bx + i % 4, level.Width - 1);
+                    const int y = std::min(by + i / 4, level.Height - 1);
+                    std::memcpy(block[i], level.Data + (y * level.Width + x) * 4, 4);
+                }
+
+                if (format == TextureFormat::BC3) {
+                    EncodeAlphaBlock(block, output);
+                    EncodeColorBlock(block, output + 8);
+                } else {
+                    EncodeColorBlock(block, output);
+                }
+                output += blockSize;
+            }
+        }
+    }
+
+    return data;
+}
+
+bool TextureData::Save(const std::string &path) const {
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+        return false;
+
+    CacheHeader header{};
+    std::memcpy(header.Magic, s_CacheMagic, sizeof(s_CacheMagic));
+    header.Version = s_CacheVersion;
+    header.Format = static_cast<unsigned int>(m_Format);
+    header.LevelCount = static_cast<unsigned int>(m_Levels.size());
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    unsigned int offset = sizeof(CacheHeader) + sizeof(CacheLevel) * header.LevelCount;
+    for (const TextureLevel& level : m_Levels) {
+        const CacheLevel entry{ level.Width, level.Height, offset, level.Size };
+        stream.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        offset += level.Size;
+    }
+
+    for (const TextureLevel& level : m_Levels)
+        stream.write(reinterpret_cast<const char*>(level.Data), level.Size);
+
+    return static_cast<bool>(stream);
+}
+
+TextureData TextureData::Load(const std::string &path) {
+    TextureData data;
+    auto file = std::make_unique<MappedFile>(path);
+    if (!file->IsValid() || file->GetSize() < sizeof(CacheHeader))
+        return data;
+
+    CacheHeader header;
+    std::memcpy(&header, file->GetData(), sizeof(header));
+    if (std::memcmp(header.Magic, s_CacheMagic, sizeof(s_CacheMagic)) != 0 || header.Version != s_CacheVersion)
+        return data;
+    if (header.Format > static_cast<unsigned int>(TextureFormat::BC3))
+        return data;
+    if (file->GetSize() < sizeof(CacheHeader) + sizeof(CacheLevel) * static_cast<size_t>(header.LevelCount))
+        return data;
+
+    const auto format = static_cast<TextureFormat>(header.Format);
+    for (unsigned int i = 0; i < header.LevelCount; i++) {
+        CacheLevel entry;
+        std::memcpy(&entry, file->GetData() + sizeof(CacheHeader) + i * sizeof(CacheLevel), sizeof(entry));
+        if (static_cast<size_t>(entry.Offset) + entry.Size > file->GetSize() || entry.Size != GetLevelSize(format, entry.Width, entry.Height)) {
+            data.m_Levels.clear();
+            return data;
+        }
+        data.m_Levels.push_back({ entry.Width, entry.Height, file->GetData() + entry.Offset, entry.Size });
+    }
+
+    data.m_Format = format;
+    data.m_File = std::move(file);
+    return data;
+}
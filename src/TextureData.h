@@ -0,0 +1,51 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+enum class TextureFormat : unsigned int {
+    RGBA8 = 0,
+    BC1 = 1, // DXT1, opaque RGB, 8 bytes per 4x4 block
+    BC3 = 2  // DXT5, RGBA, 16 bytes per 4x4 block
+};
+
+struct TextureLevel {
+    int Width, Height;
+    const unsigned char* Data;
+    unsigned int Size;
+};
+
+// Pixel data for a full mip chain, ready to upload. The bytes are owned either
+// by the object itself or by a memory-mapped cache file.
+class TextureData {
+private:
+    TextureFormat m_Format = TextureFormat::RGBA8;
+    std::vector<TextureLevel> m_Levels;
+    std::vector<unsigned char> m_Storage;
+    std::unique_ptr<MappedFile> m_File;
+
+public:
+    // RGBA8 level 0, plus a box-filtered mip chain down to 1x1 when requested
+    static TextureData FromPixels(int width, int height, const unsigned char* pixels, bool generateMipmaps);
+
+    // Block-compresses every level on the CPU
+    TextureData Compress(TextureFormat format) const;
+
+    bool Save(const std::string& path) const;
+    // Maps a cache file written by Save; levels point straight into the mapping.
+    // Returns an empty object (no levels) if the file is missing or invalid.
+    static TextureData Load(const std::string& path);
+
+    inline TextureFormat GetFormat() const { return m_Format; }
+    inline const std::vector<TextureLevel>& GetLevels() const { return m_Levels; }
+    inline bool IsValid() const { return !m_Levels.empty(); }
+
+    static unsigned int GetLevelSize(TextureFormat format, int width, int height);
+};
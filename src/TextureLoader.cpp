@@ -0,0 +1,168 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "TextureLoader.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "GLStateCache.h"
+#include "ResourceManager.h"
+#include "Profiler.h"
+#include "stb_image/stb_image.h"
+
+static constexpr unsigned char s_PlaceholderPixel[4] = { 0xff, 0x00, 0xff, 0xff };
+
+TextureLoader::TextureLoader(unsigned int workerCount) {
+    if (workerCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    GLCall(glGenBuffers(1, &m_PixelBuffer));
+
+    m_Workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++)
+        m_Workers.emplace_back(&TextureLoader::WorkerLoop, this);
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_RequestMutex);
+        m_Stopping = true;
+    }
+    m_RequestAvailable.notify_all();
+    for (std::thread& worker : m_Workers)
+        worker.join();
+
+    for (DecodedImage& image : m_Decoded)
+        stbi_image_free(image.Pixels);
+
+    GLStateCache::OnDeleteBuffer(m_PixelBuffer);
+    GLCall(glDeleteBuffers(1, &m_PixelBuffer));
+}
+
+std::shared_ptr<Texture> TextureLoader::Load(const std::string &path) {
+    std::weak_ptr<Texture>& loaded = m_Loaded[ResourceManager::NormalizePath(path)];
+    if (std::shared_ptr<Texture> existing = loaded.lock())
+        return existing;
+
+    auto texture = std::make_shared<Texture>(1, 1, s_PlaceholderPixel);
+    loaded = texture;
+    {
+        std::lock_guard<std::mutex> lock(m_RequestMutex);
+        m_Requests.push_back({ texture, path });
+        m_InFlight++;
+    }
+    m_RequestAvailable.notify_one();
+    return texture;
+}
+
+void TextureLoader::WorkerLoop() {
+    // The flip flag is per thread when stb_image is built with thread locals
+    stbi_set_flip_vertically_on_load_thread(1);
+    Profiler::SetThreadName("TextureLoader");
+
+    while (true) {
+        DecodeRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_RequestMutex);
+            m_RequestAvailable.wait(lock, [this] { return m_Stopping || !m_Requests.empty(); });
+            if (m_Stopping)
+                return;
+            request = std::move(m_Requests.front());
+            m_Requests.pop_front();
+        }
+
+        DecodedImage image{ std::move(request.Target), std::move(request.Path), nullptr, 0, 0, nullptr };
+        {
+            PROFILE_SCOPE("TextureLoader::Decode");
+            int channels;
+            image.Pixels = stbi_load(image.Path.c_str(), &image.Width, &image.Height, &channels, 4);
+            if (!image.Pixels)
+                image.FailureReason = stbi_failure_reason();
+        }
+
+        std::lock_guard<std::mutex> lock(m_DecodedMutex);
+        m_Decoded.push_back(std::move(image));
+    }
+}
+
+void TextureLoader::ProcessUploads(double budgetMilliseconds, unsigned int budgetBytes) {
+    PROFILE_GPU_SCOPE("TextureLoader::ProcessUploads");
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    unsigned int bytes = 0;
+
+    while (true) {
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> lock(m_DecodedMutex);
+            if (m_Decoded.empty())
+                break;
+            image = std::move(m_Decoded.front());
+            m_Decoded.pop_front();
+        }
+
+        Upload(image);
+        bytes += image.Width * image.Height * 4;
+
+        const double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (elapsed >= budgetMilliseconds || bytes >= budgetBytes)
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(m_RequestMutex);
+    m_Stats.Pending = m_InFlight;
+}
+
+void TextureLoader::Finish() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            if (m_InFlight == 0)
+                break;
+        }
+        ProcessUploads(1000.0, ~0u);
+        std::this_thread::yield();
+    }
+}
+
+void TextureLoader::Upload(DecodedImage &image) {
+    {
+        std::lock_guard<std::mutex> lock(m_RequestMutex);
+        m_InFlight--;
+    }
+
+    if (!image.Pixels) {
+        std::cout << "Failed to load texture '" << image.Path << "': "
+                  << (image.FailureReason ? image.FailureReason : "unknown error") << std::endl;
+        return;
+    }
+
+    // Stage through a pixel buffer: orphaning it hands the driver a fresh block,
+    // so the copy never waits for last frame's transfer and glTexImage2D can
+    // return before the DMA completes
+    const unsigned int size = image.Width * image.Height * 4;
+    GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PixelBuffer);
+    GLCall(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+    void* mapped;
+    GLCall(mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    std::memcpy(mapped, image.Pixels, size);
+    GLCall(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+    image.Target->SetData(image.Width, image.Height, nullptr);
+    GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    stbi_image_free(image.Pixels);
+
+    m_Stats.Uploads++;
+    m_Stats.UploadedBytes += size;
+}
+
+void TextureLoader::ResetStats() {
+    m_Stats.Uploads = 0;
+    m_Stats.UploadedBytes = 0;
+}
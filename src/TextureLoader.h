@@ -0,0 +1,85 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "StringHash.h"
+#include "Texture.h"
+
+// Decodes image files on a pool of worker threads and uploads them on the
+// render thread a few at a time. Load returns straight away with a texture
+// that shows a placeholder until its pixels are resident.
+class TextureLoader {
+public:
+    struct Stats {
+        unsigned int Uploads = 0;
+        unsigned int UploadedBytes = 0;
+        unsigned int Pending = 0;
+    };
+
+private:
+    struct DecodeRequest {
+        std::shared_ptr<Texture> Target;
+        std::string Path;
+    };
+
+    struct DecodedImage {
+        std::shared_ptr<Texture> Target;
+        std::string Path;
+        unsigned char* Pixels;
+        int Width, Height;
+        // stb_image keeps its failure reason per thread, so it is captured on the worker
+        const char* FailureReason;
+    };
+
+    std::vector<std::thread> m_Workers;
+    std::deque<DecodeRequest> m_Requests;
+    std::deque<DecodedImage> m_Decoded;
+    std::mutex m_RequestMutex;
+    std::mutex m_DecodedMutex;
+    std::condition_variable m_RequestAvailable;
+    bool m_Stopping{};
+    unsigned int m_InFlight{};
+
+    // Textures already requested, so loading a path twice shares one texture
+    std::unordered_map<std::string, std::weak_ptr<Texture>, StringHash, std::equal_to<>> m_Loaded;
+
+    unsigned int m_PixelBuffer{};
+    Stats m_Stats;
+
+public:
+    // workerCount 0 uses one thread per core, minus the render thread
+    explicit TextureLoader(unsigned int workerCount = 0);
+    ~TextureLoader();
+
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    // Loading a path that is still alive returns the texture already requested;
+    // paths are compared normalized, as in ResourceManager
+    std::shared_ptr<Texture> Load(const std::string& path);
+
+    // Render thread only. Uploads decoded images until either budget is spent;
+    // at least one image goes up per call so large images cannot starve.
+    void ProcessUploads(double budgetMilliseconds = 2.0, unsigned int budgetBytes = 16 * 1024 * 1024);
+    // Blocks until every requested texture is uploaded, e.g. behind a loading screen
+    void Finish();
+
+    inline unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_Workers.size()); }
+    inline const Stats& GetStats() const { return m_Stats; }
+    void ResetStats();
+
+private:
+    void WorkerLoop();
+    void Upload(DecodedImage& image);
+};
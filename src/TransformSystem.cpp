@@ -0,0 +1,162 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "TransformSystem.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define TRANSFORM_SSE 1
+#else
+    #define TRANSFORM_SSE 0
+#endif
+
+#if TRANSFORM_SSE
+// Column j of a * b is a's columns weighted by the entries of b's column j.
+// The left matrix stays in registers, which is what makes batching pay off.
+static inline void MultiplyColumns(__m128 a0, __m128 a1, __m128 a2, __m128 a3, const float* b, float* out) {
+    for (int j = 0; j < 4; j++) {
+        const float* column = b + j * 4;
+        __m128 result = _mm_mul_ps(a0, _mm_set1_ps(column[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(column[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(column[2])));
+        result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(column[3])));
+        _mm_storeu_ps(out + j * 4, result);
+    }
+}
+#endif
+
+void MatrixBatch::Multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+#if TRANSFORM_SSE
+    const float* left = &a[0][0];
+    MultiplyColumns(_mm_loadu_ps(left), _mm_loadu_ps(left + 4), _mm_loadu_ps(left + 8), _mm_loadu_ps(left + 12),
+                    &b[0][0], &out[0][0]);
+#else
+    out = a * b;
+#endif
+}
+
+void MatrixBatch::Multiply(const glm::mat4& lhs, const glm::mat4* rhs, glm::mat4* out, size_t count) {
+#if TRANSFORM_SSE
+    const float* left = &lhs[0][0];
+    const __m128 a0 = _mm_loadu_ps(left);
+    const __m128 a1 = _mm_loadu_ps(left + 4);
+    const __m128 a2 = _mm_loadu_ps(left + 8);
+    const __m128 a3 = _mm_loadu_ps(left + 12);
+    for (size_t i = 0; i < count; i++)
+        MultiplyColumns(a0, a1, a2, a3, &rhs[i][0][0], &out[i][0][0]);
+#else
+    for (size_t i = 0; i < count; i++)
+        out[i] = lhs * rhs[i];
+#endif
+}
+
+// T * R * S without building and multiplying three matrices
+static inline void ComposeLocal(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4& out) {
+    const glm::mat3 r = glm::mat3_cast(rotation);
+    out[0] = glm::vec4(r[0] * scale.x, 0.0f);
+    out[1] = glm::vec4(r[1] * scale.y, 0.0f);
+    out[2] = glm::vec4(r[2] * scale.z, 0.0f);
+    out[3] = glm::vec4(position, 1.0f);
+}
+
+TransformID TransformSystem::Create(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, TransformID parent) {
+    const TransformID id = static_cast<TransformID>(m_Positions.size());
+    m_Positions.push_back(position);
+    m_Rotations.push_back(rotation);
+    m_Scales.push_back(scale);
+    m_Parents.push_back(parent < id ? parent : InvalidTransform);
+    m_Dirty.push_back(1);
+    m_WorldMatrices.emplace_back(1.0f);
+    m_AnyDirty = true;
+    return id;
+}
+
+void TransformSystem::Reserve(size_t count) {
+    m_Positions.reserve(count);
+    m_Rotations.reserve(count);
+    m_Scales.reserve(count);
+    m_Parents.reserve(count);
+    m_Dirty.reserve(count);
+    m_WorldMatrices.reserve(count);
+}
+
+void TransformSystem::Clear() {
+    m_Positions.clear();
+    m_Rotations.clear();
+    m_Scales.clear();
+    m_Parents.clear();
+    m_Dirty.clear();
+    m_WorldMatrices.clear();
+    m_AnyDirty = false;
+    m_ChangedBegin = m_ChangedEnd = 0;
+}
+
+void TransformSystem::MarkDirty(TransformID id) {
+    m_Dirty[id] = 1;
+    m_AnyDirty = true;
+}
+
+void TransformSystem::SetPosition(TransformID id, const glm::vec3& position) {
+    if (m_Positions[id] == position)
+        return;
+    m_Positions[id] = position;
+    MarkDirty(id);
+}
+
+void TransformSystem::SetRotation(TransformID id, const glm::quat& rotation) {
+    if (m_Rotations[id] == rotation)
+        return;
+    m_Rotations[id] = rotation;
+    MarkDirty(id);
+}
+
+void TransformSystem::SetScale(TransformID id, const glm::vec3& scale) {
+    if (m_Scales[id] == scale)
+        return;
+    m_Scales[id] = scale;
+    MarkDirty(id);
+}
+
+void TransformSystem::Update() {
+    m_ChangedBegin = m_ChangedEnd = 0;
+    if (!m_AnyDirty)
+        return;
+
+    PROFILE_SCOPE("TransformSystem::Update");
+
+    const TransformID count = static_cast<TransformID>(m_Positions.size());
+    TransformID first = count;
+    TransformID last = 0;
+    for (TransformID i = 0; i < count; i++) {
+        // Parents come first, so their flag is final by the time a child is reached
+        const TransformID parent = m_Parents[i];
+        if (parent != InvalidTransform && m_Dirty[parent])
+            m_Dirty[i] = 1;
+        if (!m_Dirty[i])
+            continue;
+
+        ComposeLocal(m_Positions[i], m_Rotations[i], m_Scales[i], m_WorldMatrices[i]);
+        if (parent != InvalidTransform)
+            MatrixBatch::Multiply(m_WorldMatrices[parent], m_WorldMatrices[i], m_WorldMatrices[i]);
+
+        first = std::min(first, i);
+        last = i + 1;
+    }
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+    m_AnyDirty = false;
+    if (first < last) {
+        m_ChangedBegin = first;
+        m_ChangedEnd = last;
+    }
+}
+
+void TransformSystem::ComputeMVP(const glm::mat4& viewProjection, TransformID first, size_t count, glm::mat4* out) const {
+    PROFILE_SCOPE("TransformSystem::ComputeMVP");
+    MatrixBatch::Multiply(viewProjection, m_WorldMatrices.data() + first, out, count);
+}
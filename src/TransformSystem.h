@@ -0,0 +1,70 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+using TransformID = uint32_t;
+static constexpr TransformID InvalidTransform = ~0u;
+
+// Transforms stored as structure-of-arrays. A parent is always created before
+// its children, so one forward pass over the arrays updates a whole hierarchy.
+// Only transforms whose local values (or whose parent) changed are recomputed.
+class TransformSystem {
+private:
+    std::vector<glm::vec3> m_Positions;
+    std::vector<glm::quat> m_Rotations;
+    std::vector<glm::vec3> m_Scales;
+    std::vector<TransformID> m_Parents;
+    std::vector<uint8_t> m_Dirty;
+    std::vector<glm::mat4> m_WorldMatrices;
+    bool m_AnyDirty = false;
+    TransformID m_ChangedBegin = 0;
+    TransformID m_ChangedEnd = 0;
+public:
+    TransformID Create(const glm::vec3& position, const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                       const glm::vec3& scale = glm::vec3(1.0f), TransformID parent = InvalidTransform);
+    void Reserve(size_t count);
+    void Clear();
+
+    // Setters only mark the transform dirty when the value actually changes
+    void SetPosition(TransformID id, const glm::vec3& position);
+    void SetRotation(TransformID id, const glm::quat& rotation);
+    void SetScale(TransformID id, const glm::vec3& scale);
+
+    inline const glm::vec3& GetPosition(TransformID id) const { return m_Positions[id]; }
+    inline const glm::quat& GetRotation(TransformID id) const { return m_Rotations[id]; }
+    inline const glm::vec3& GetScale(TransformID id) const { return m_Scales[id]; }
+    inline TransformID GetParent(TransformID id) const { return m_Parents[id]; }
+
+    // Recomputes the world matrices of dirty transforms and their descendants
+    void Update();
+
+    // World matrices are contiguous and indexed by TransformID, ready to be
+    // uploaded as per-instance data
+    inline const glm::mat4& GetWorldMatrix(TransformID id) const { return m_WorldMatrices[id]; }
+    inline const glm::mat4* GetWorldMatrices() const { return m_WorldMatrices.data(); }
+    inline size_t GetCount() const { return m_WorldMatrices.size(); }
+
+    // [begin, end) of the world matrices the last Update changed; empty when nothing did
+    inline TransformID GetChangedBegin() const { return m_ChangedBegin; }
+    inline TransformID GetChangedEnd() const { return m_ChangedEnd; }
+
+    // out[i] = viewProjection * world[first + i] for count transforms
+    void ComputeMVP(const glm::mat4& viewProjection, TransformID first, size_t count, glm::mat4* out) const;
+
+private:
+    void MarkDirty(TransformID id);
+};
+
+// 4x4 products with SSE when available. out may alias either input.
+namespace MatrixBatch {
+    void Multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out);
+    // out[i] = lhs * rhs[i]
+    void Multiply(const glm::mat4& lhs, const glm::mat4* rhs, glm::mat4* out, size_t count);
+}
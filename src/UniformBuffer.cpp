@@ -0,0 +1,34 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "UniformBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding) : m_Size(size), m_Binding(binding) {
+    m_RendererID = GLObjectPool::CreateBuffer();
+    GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    Bind();
+}
+
+UniformBuffer::~UniformBuffer() {
+    GLObjectPool::DestroyBuffer(m_RendererID);
+}
+
+void UniformBuffer::SetData(const void *data, unsigned int size, unsigned int offset) {
+    ASSERT(offset + size <= m_Size);
+    GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+}
+
+void UniformBuffer::Bind() const {
+    GLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID);
+}
+
+void UniformBuffer::Unbind() const {
+    GLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, 0);
+}
@@ -0,0 +1,92 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Data shared by every shader through the "Frame" uniform block, uploaded once per frame
+struct FrameUniforms {
+    glm::mat4 View;
+    glm::mat4 Projection;
+    glm::mat4 ViewProjection;
+    glm::vec4 Time; // x = seconds since start, y = delta seconds
+};
+
+static_assert(sizeof(FrameUniforms) == 3 * 64 + 16, "FrameUniforms must match the std140 Frame block");
+
+constexpr unsigned int FrameUniformBinding = 0;
+
+class UniformBuffer {
+private:
+    unsigned int m_RendererID{};
+    unsigned int m_Size;
+    unsigned int m_Binding;
+public:
+    UniformBuffer(unsigned int size, unsigned int binding);
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+    // Attaches the buffer to its binding point, where shaders' blocks read from
+    void Bind() const;
+    void Unbind() const;
+
+    inline unsigned int GetSize() const { return m_Size; }
+    inline unsigned int GetBinding() const { return m_Binding; }
+};
+
+// std140 base alignment and size of the types a uniform block can hold
+template<typename T> struct Std140 { static_assert(sizeof(T) == 0, "Unsupported type in std140 block"); };
+template<> struct Std140<float>     { static constexpr unsigned int Alignment = 4;  static constexpr unsigned int Size = 4; };
+template<> struct Std140<int>       { static constexpr unsigned int Alignment = 4;  static constexpr unsigned int Size = 4; };
+template<> struct Std140<glm::vec2> { static constexpr unsigned int Alignment = 8;  static constexpr unsigned int Size = 8; };
+template<> struct Std140<glm::vec3> { static constexpr unsigned int Alignment = 16; static constexpr unsigned int Size = 12; };
+template<> struct Std140<glm::vec4> { static constexpr unsigned int Alignment = 16; static constexpr unsigned int Size = 16; };
+template<> struct Std140<glm::mat4> { static constexpr unsigned int Alignment = 16; static constexpr unsigned int Size = 64; };
+
+// Packs values one after another following std140 rules, for blocks whose
+// layout is only known at runtime
+class Std140Writer {
+private:
+    std::vector<unsigned char> m_Data;
+
+public:
+    // Returns the offset the value was written at
+    template<typename T>
+    unsigned int Write(const T& value) {
+        const unsigned int offset = AlignTo(Std140<T>::Alignment);
+        m_Data.resize(offset + Std140<T>::Size);
+        std::memcpy(m_Data.data() + offset, &value, Std140<T>::Size);
+        return offset;
+    }
+
+    // Array elements are padded to a vec4 stride
+    template<typename T>
+    unsigned int WriteArray(const T* values, unsigned int count) {
+        const unsigned int stride = (Std140<T>::Size + 15) / 16 * 16;
+        const unsigned int offset = AlignTo(16);
+        m_Data.resize(offset + stride * count);
+        for (unsigned int i = 0; i < count; i++)
+            std::memcpy(m_Data.data() + offset + i * stride, &values[i], Std140<T>::Size);
+        return offset;
+    }
+
+    inline void Clear() { m_Data.clear(); }
+    inline const void* GetData() const { return m_Data.data(); }
+    // Size rounded up to a vec4, as the block itself is
+    inline unsigned int GetSize() const { return (static_cast<unsigned int>(m_Data.size()) + 15) / 16 * 16; }
+
+private:
+    unsigned int AlignTo(unsigned int alignment) {
+        const unsigned int offset = (static_cast<unsigned int>(m_Data.size()) + alignment - 1) / alignment * alignment;
+        m_Data.resize(offset);
+        return offset;
+    }
+};
@@ -4,36 +4,84 @@
 
 #include "VertexArray.h"
 
+#include <cstdint>
+#include <utility>
+
 #include "VertexBufferLayout.h"
+#include "DynamicVertexBuffer.h"
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
 
 VertexArray::VertexArray() {
-    GLCall(glGenVertexArrays(1, &m_RendererID));
+    m_RendererID = GLObjectPool::CreateVertexArray();
 }
 
 VertexArray::~VertexArray() {
-    GLCall(glDeleteVertexArrays(1, &m_RendererID));
+    GLObjectPool::DestroyVertexArray(m_RendererID);
+}
+
+VertexArray::VertexArray(VertexArray &&other) noexcept
+    : m_RendererID(std::exchange(other.m_RendererID, 0)), m_AttribIndex(std::exchange(other.m_AttribIndex, 0)) {
+}
+
+VertexArray &VertexArray::operator=(VertexArray &&other) noexcept {
+    if (this != &other) {
+        GLObjectPool::DestroyVertexArray(m_RendererID);
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_AttribIndex = std::exchange(other.m_AttribIndex, 0);
+    }
+    return *this;
 }
 
 void VertexArray::AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &layout) {
     Bind();
     vb.Bind();
+    AddLayout(layout);
+}
+
+void VertexArray::AddBuffer(const DynamicVertexBuffer &vb, const VertexBufferLayout &layout) {
+    Bind();
+    vb.Bind();
+    AddLayout(layout);
+}
+
+void VertexArray::SetBufferOffset(const DynamicVertexBuffer &vb, const VertexBufferLayout &layout, unsigned int firstAttrib,
+                                  unsigned int offset) {
+    Bind();
+    vb.Bind();
+    SetAttributes(layout, firstAttrib, offset);
+}
+
+void VertexArray::AddLayout(const VertexBufferLayout &layout) {
+    SetAttributes(layout, m_AttribIndex, 0);
+    m_AttribIndex += static_cast<unsigned int>(layout.GetElements().size());
+}
+
+void VertexArray::SetAttributes(const VertexBufferLayout &layout, unsigned int firstAttrib, unsigned int offset) {
     const auto &elements = layout.GetElements();
-    unsigned int offset = 0;
-    for (unsigned int i = 0; i < elements.size(); i++) {
-        const auto &element = elements[i];
-        GLCall(glEnableVertexAttribArray(i));
-        GLCall(glVertexAttribPointer(i, element.count, element.type,
-            element.normalized, layout.GetStride(), reinterpret_cast<const void *>(offset)));
-        offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+    unsigned int index = firstAttrib;
+    for (const auto &element : elements) {
+        GLCall(glEnableVertexAttribArray(index));
+        if (element.integer) {
+            GLCall(glVertexAttribIPointer(index, element.count, element.type,
+                layout.GetStride(), reinterpret_cast<const void *>(static_cast<uintptr_t>(offset))));
+        } else {
+            GLCall(glVertexAttribPointer(index, element.count, element.type,
+                element.normalized, layout.GetStride(), reinterpret_cast<const void *>(static_cast<uintptr_t>(offset))));
+        }
+        if (element.divisor != 0) {
+            GLCall(glVertexAttribDivisor(index, element.divisor));
+        }
+        offset += element.GetSize();
+        index++;
     }
 }
 
 void VertexArray::Bind() const {
-    GLCall(glBindVertexArray(m_RendererID));
+    GLStateCache::BindVertexArray(m_RendererID);
 }
 
 void VertexArray::Unbind() const {
-    GLCall(glBindVertexArray(0));
-
+    GLStateCache::BindVertexArray(0);
 }
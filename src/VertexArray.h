@@ -7,16 +7,36 @@
 #include "VertexBuffer.h"
 
 class VertexBufferLayout;
+class DynamicVertexBuffer;
 
 class VertexArray {
 private:
     unsigned int m_RendererID{};
+    unsigned int m_AttribIndex{};
 public:
     VertexArray();
     ~VertexArray();
 
+    VertexArray(const VertexArray&) = delete;
+    VertexArray& operator=(const VertexArray&) = delete;
+    VertexArray(VertexArray&& other) noexcept;
+    VertexArray& operator=(VertexArray&& other) noexcept;
+
+    // Each call appends the layout's attributes after the ones already added,
+    // so per-vertex and per-instance data can live in separate buffers
     void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+    void AddBuffer(const DynamicVertexBuffer& vb, const VertexBufferLayout& layout);
+    // Points the attributes layout added, from firstAttrib on, at offset bytes
+    // into vb, e.g. where a DynamicVertexBuffer allocation landed this frame
+    void SetBufferOffset(const DynamicVertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttrib, unsigned int offset);
 
     void Bind() const;
     void Unbind() const;
+
+    inline unsigned int GetAttribCount() const { return m_AttribIndex; }
+    inline unsigned int GetRendererID() const { return m_RendererID; }
+
+private:
+    void AddLayout(const VertexBufferLayout& layout);
+    void SetAttributes(const VertexBufferLayout& layout, unsigned int firstAttrib, unsigned int offset);
 };
@@ -4,23 +4,51 @@
 
 #include "VertexBuffer.h"
 
+#include <utility>
+
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLObjectPool.h"
 
-VertexBuffer::VertexBuffer(const void *data, unsigned int size) {
-    GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+VertexBuffer::VertexBuffer(const void *data, unsigned int size) : m_Size(size) {
+    m_RendererID = GLObjectPool::CreateBuffer();
+    Bind();
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
 }
 
+VertexBuffer::VertexBuffer(unsigned int size) : m_Size(size) {
+    m_RendererID = GLObjectPool::CreateBuffer();
+    Bind();
+    GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+}
+
 VertexBuffer::~VertexBuffer() {
-    GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLObjectPool::DestroyBuffer(m_RendererID);
 }
 
-void VertexBuffer::Bind() const {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+VertexBuffer::VertexBuffer(VertexBuffer &&other) noexcept
+    : m_RendererID(std::exchange(other.m_RendererID, 0)), m_Size(std::exchange(other.m_Size, 0)) {
+}
 
+VertexBuffer &VertexBuffer::operator=(VertexBuffer &&other) noexcept {
+    if (this != &other) {
+        GLObjectPool::DestroyBuffer(m_RendererID);
+        m_RendererID = std::exchange(other.m_RendererID, 0);
+        m_Size = std::exchange(other.m_Size, 0);
+    }
+    return *this;
+}
+
+void VertexBuffer::SetData(const void *data, unsigned int size, unsigned int offset) {
+    ASSERT(offset + size <= m_Size);
+    Bind();
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+}
+
+void VertexBuffer::Bind() const {
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::Unbind() const {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
 }
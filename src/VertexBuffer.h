@@ -7,11 +7,24 @@
 class VertexBuffer {
 private:
     unsigned int m_RendererID{};
+    unsigned int m_Size{};
 public:
     VertexBuffer(const void* data, unsigned int size);
+    // Dynamic buffer with no initial contents, filled later through SetData
+    explicit VertexBuffer(unsigned int size);
     ~VertexBuffer();
 
+    VertexBuffer(const VertexBuffer&) = delete;
+    VertexBuffer& operator=(const VertexBuffer&) = delete;
+    VertexBuffer(VertexBuffer&& other) noexcept;
+    VertexBuffer& operator=(VertexBuffer&& other) noexcept;
+
+    void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
     void Bind() const;
 
     void Unbind() const;
+
+    inline unsigned int GetSize() const { return m_Size; }
+    inline unsigned int GetRendererID() const { return m_RendererID; }
 };
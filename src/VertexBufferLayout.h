@@ -6,21 +6,40 @@
 
 #include <vector>
 #include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "VertexPacking.h"
 
 struct VertexBufferElement {
     unsigned int type;
     unsigned int count;
     unsigned char normalized;
+    // 0 advances per vertex, N advances once every N instances
+    unsigned int divisor;
+    // Read as ivec/uvec through glVertexAttribIPointer instead of converted to float
+    unsigned char integer = GL_FALSE;
 
     static unsigned int GetSizeOfType(unsigned int type) {
         switch (type) {
             case GL_FLOAT: return 4; // NOLINT(*-branch-clone)
+            case GL_INT: return 4;
             case GL_UNSIGNED_INT: return 4;
+            case GL_HALF_FLOAT: return 2;
+            case GL_SHORT: return 2;
+            case GL_UNSIGNED_SHORT: return 2;
+            case GL_BYTE: return 1;
             case GL_UNSIGNED_BYTE: return 1;
             default: ;
         }
         return 0;
     }
+
+    // Packed types hold all four components in one word
+    inline unsigned int GetSize() const {
+        if (type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV)
+            return 4;
+        return count * GetSizeOfType(type);
+    }
 };
 
 class VertexBufferLayout {
@@ -33,29 +52,91 @@ public:
         : m_Stride(0) {}
 
     template<typename T>
-    void Push(unsigned int count) {
+    void Push(unsigned int count, unsigned int divisor = 0) {
         static_assert(sizeof(T) == 0, "Unsupported type in VertexBufferLayout::Push");
     }
 
+    // Integer attributes, declared int/uint/ivecN/uvecN in the shader
+    template<typename T>
+    void PushInteger(unsigned int count, unsigned int divisor = 0) {
+        static_assert(sizeof(T) == 0, "Unsupported type in VertexBufferLayout::PushInteger");
+    }
+
+    // An element described at runtime, e.g. read back from a mesh file
+    void Add(const VertexBufferElement& element) {
+        m_Elements.push_back(element);
+        m_Stride += element.GetSize();
+    }
 
     inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
     inline unsigned int GetStride() const { return m_Stride; }
 };
 
 template<>
-inline void VertexBufferLayout::Push<float>(unsigned int count) {
-    m_Elements.push_back({ GL_FLOAT, count, GL_FALSE });
-    m_Stride += VertexBufferElement::GetSizeOfType(GL_FLOAT) * count;
+inline void VertexBufferLayout::Push<float>(unsigned int count, unsigned int divisor) {
+    Add({ GL_FLOAT, count, GL_FALSE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<unsigned int>(unsigned int count, unsigned int divisor) {
+    Add({ GL_UNSIGNED_INT, count, GL_FALSE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<unsigned char>(unsigned int count, unsigned int divisor) {
+    Add({ GL_UNSIGNED_BYTE, count, GL_TRUE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<HalfFloat>(unsigned int count, unsigned int divisor) {
+    Add({ GL_HALF_FLOAT, count, GL_FALSE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<NormalizedShort>(unsigned int count, unsigned int divisor) {
+    Add({ GL_SHORT, count, GL_TRUE, divisor });
+}
+
+template<>
+inline void VertexBufferLayout::Push<NormalizedUShort>(unsigned int count, unsigned int divisor) {
+    Add({ GL_UNSIGNED_SHORT, count, GL_TRUE, divisor });
+}
+
+// Each packed attribute is a vec4 in one word, so count is attributes, not components
+template<>
+inline void VertexBufferLayout::Push<PackedNormal>(unsigned int count, unsigned int divisor) {
+    for (unsigned int i = 0; i < count; i++)
+        Add({ GL_INT_2_10_10_10_REV, 4, GL_TRUE, divisor });
+}
+
+// A mat4 attribute occupies four consecutive locations, one vec4 column each
+template<>
+inline void VertexBufferLayout::Push<glm::mat4>(unsigned int count, unsigned int divisor) {
+    for (unsigned int i = 0; i < count * 4; i++)
+        Push<float>(4, divisor);
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<int>(unsigned int count, unsigned int divisor) {
+    Add({ GL_INT, count, GL_FALSE, divisor, GL_TRUE });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<unsigned int>(unsigned int count, unsigned int divisor) {
+    Add({ GL_UNSIGNED_INT, count, GL_FALSE, divisor, GL_TRUE });
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<short>(unsigned int count, unsigned int divisor) {
+    Add({ GL_SHORT, count, GL_FALSE, divisor, GL_TRUE });
 }
 
 template<>
-inline void VertexBufferLayout::Push<unsigned int>(unsigned int count) {
-    m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE });
-    m_Stride += VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT) * count;
+inline void VertexBufferLayout::PushInteger<unsigned short>(unsigned int count, unsigned int divisor) {
+    Add({ GL_UNSIGNED_SHORT, count, GL_FALSE, divisor, GL_TRUE });
 }
 
 template<>
-inline void VertexBufferLayout::Push<unsigned char>(unsigned int count) {
-    m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE });
-    m_Stride += VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE) * count;
+inline void VertexBufferLayout::PushInteger<unsigned char>(unsigned int count, unsigned int divisor) {
+    Add({ GL_UNSIGNED_BYTE, count, GL_FALSE, divisor, GL_TRUE });
 }
@@ -0,0 +1,258 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PACKING_SSE2 1
+#else
+    #define PACKING_SSE2 0
+#endif
+
+// Hardware half conversion when the build targets it (-mf16c or -march with it)
+#if PACKING_SSE2 && defined(__F16C__)
+    #include <immintrin.h>
+    #define PACKING_F16C 1
+#else
+    #define PACKING_F16C 0
+#endif
+
+static inline uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float BitsFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// NaN clamps to the low end, matching what _mm_max_ps does with it
+static inline float Clamp(float value, float low, float high) {
+    return std::min(std::max(low, value), high);
+}
+
+HalfFloat VertexPacking::ToHalf(float value) {
+    uint32_t bits = FloatBits(value);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half;
+    if (bits >= 0x47800000u) {
+        // Too large for a half, infinity or NaN
+        half = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+    } else if (bits < 0x38800000u) {
+        // Subnormal or zero: adding 0.5 lines the half mantissa up with the float's and rounds it
+        half = FloatBits(BitsFloat(bits) + 0.5f) - FloatBits(0.5f);
+    } else {
+        // Rebias the exponent and round to nearest even on the 13 dropped bits
+        const uint32_t oddMantissa = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + oddMantissa;
+        half = bits >> 13;
+    }
+    return { static_cast<uint16_t>(half | sign >> 16) };
+}
+
+float VertexPacking::FromHalf(HalfFloat value) {
+    const uint32_t sign = static_cast<uint32_t>(value.Bits & 0x8000) << 16;
+    const uint32_t exponent = (value.Bits >> 10) & 0x1f;
+    const uint32_t mantissa = value.Bits & 0x3ff;
+    if (exponent == 0)
+        return BitsFloat(sign | FloatBits(mantissa * 5.9604645e-8f)); // 2^-24
+    if (exponent == 0x1f)
+        return BitsFloat(sign | 0x7f800000u | mantissa << 13);
+    return BitsFloat(sign | (exponent + 127 - 15) << 23 | mantissa << 13);
+}
+
+NormalizedShort VertexPacking::ToNormalizedShort(float value) {
+    return { static_cast<int16_t>(std::nearbyint(Clamp(value, -1.0f, 1.0f) * 32767.0f)) };
+}
+
+NormalizedUShort VertexPacking::ToNormalizedUShort(float value) {
+    return { static_cast<uint16_t>(std::nearbyint(Clamp(value, 0.0f, 1.0f) * 65535.0f)) };
+}
+
+PackedNormal VertexPacking::ToPackedNormal(const glm::vec4 &value) {
+    const auto x = static_cast<int32_t>(std::nearbyint(Clamp(value.x, -1.0f, 1.0f) * 511.0f));
+    const auto y = static_cast<int32_t>(std::nearbyint(Clamp(value.y, -1.0f, 1.0f) * 511.0f));
+    const auto z = static_cast<int32_t>(std::nearbyint(Clamp(value.z, -1.0f, 1.0f) * 511.0f));
+    const auto w = static_cast<int32_t>(std::nearbyint(Clamp(value.w, -1.0f, 1.0f)));
+    return { (static_cast<uint32_t>(x) & 0x3ff) | (static_cast<uint32_t>(y) & 0x3ff) << 10
+           | (static_cast<uint32_t>(z) & 0x3ff) << 20 | static_cast<uint32_t>(w) << 30 };
+}
+
+#if PACKING_SSE2 && !PACKING_F16C
+// ToHalf on four lanes. Results stay sign-extended in 32-bit lanes so
+// _mm_packs_epi32 narrows them without saturating.
+static inline __m128i FloatToHalf4(__m128 value) {
+    const __m128 sign = _mm_and_ps(value, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u))));
+    const __m128 magnitude = _mm_xor_ps(value, sign);
+    const __m128i bits = _mm_castps_si128(magnitude);
+
+    const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(magnitude, magnitude));
+    const __m128i special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+    const __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+    const __m128i isSubnormal = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+
+    const __m128i half = _mm_castps_si128(_mm_set1_ps(0.5f));
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(magnitude, _mm_castsi128_ps(half))), half);
+
+    const __m128i oddMantissa = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31);
+    const __m128i rounded = _mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(15 - 127) << 23) + 0xfff))), oddMantissa);
+    const __m128i normal = _mm_srli_epi32(rounded, 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+    const __m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+    return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+#endif
+
+// The run functions convert n floats to n tightly packed values; the SIMD
+// loops take eight at a time and the scalar path finishes the rest
+static void HalfRun(const float* source, size_t n, unsigned char* destination) {
+    size_t i = 0;
+#if PACKING_F16C
+    for (; i + 8 <= n; i += 8) {
+        const __m128i low = _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        const __m128i high = _mm_cvtps_ph(_mm_loadu_ps(source + i + 4), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_unpacklo_epi64(low, high));
+    }
+#elif PACKING_SSE2
+    for (; i + 8 <= n; i += 8) {
+        const __m128i low = FloatToHalf4(_mm_loadu_ps(source + i));
+        const __m128i high = FloatToHalf4(_mm_loadu_ps(source + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_packs_epi32(low, high));
+    }
+#endif
+    for (; i < n; i++) {
+        const HalfFloat half = VertexPacking::ToHalf(source[i]);
+        std::memcpy(destination + i * 2, &half, 2);
+    }
+}
+
+static void NormalizedShortRun(const float* source, size_t n, unsigned char* destination) {
+    size_t i = 0;
+#if PACKING_SSE2
+    const __m128 low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= n; i += 8) {
+        const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), low), high), scale));
+        const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 4), low), high), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_packs_epi32(a, b));
+    }
+#endif
+    for (; i < n; i++) {
+        const NormalizedShort value = VertexPacking::ToNormalizedShort(source[i]);
+        std::memcpy(destination + i * 2, &value, 2);
+    }
+}
+
+static void NormalizedUShortRun(const float* source, size_t n, unsigned char* destination) {
+    size_t i = 0;
+#if PACKING_SSE2
+    // SSE2 can only narrow with signed saturation, so shift into the signed range and back
+    const __m128 low = _mm_setzero_ps(), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(65535.0f);
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 8 <= n; i += 8) {
+        const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), low), high), scale));
+        const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 4), low), high), scale));
+        const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_xor_si128(packed, flip));
+    }
+#endif
+    for (; i < n; i++) {
+        const NormalizedUShort value = VertexPacking::ToNormalizedUShort(source[i]);
+        std::memcpy(destination + i * 2, &value, 2);
+    }
+}
+
+// Tightly packed output is one run over everything. Strided output goes
+// through a staging buffer a chunk at a time and is spread out from there.
+template<typename Run>
+static void PackComponents(const float* source, size_t count, unsigned int components, size_t valueSize,
+                           void* destination, size_t stride, Run run) {
+    const size_t vectorSize = components * valueSize;
+    auto* out = static_cast<unsigned char*>(destination);
+    if (stride == 0 || stride == vectorSize) {
+        run(source, count * components, out);
+        return;
+    }
+
+    constexpr size_t StagingSize = 4096;
+    unsigned char staging[StagingSize];
+    const size_t chunk = std::max<size_t>(StagingSize / vectorSize, 1);
+    for (size_t first = 0; first < count; first += chunk) {
+        const size_t vectors = std::min(chunk, count - first);
+        run(source + first * components, vectors * components, staging);
+        for (size_t i = 0; i < vectors; i++)
+            std::memcpy(out + (first + i) * stride, staging + i * vectorSize, vectorSize);
+    }
+}
+
+void VertexPacking::PackHalf(const float *source, size_t count, unsigned int components, void *destination, size_t stride) {
+    PackComponents(source, count, components, sizeof(HalfFloat), destination, stride, HalfRun);
+}
+
+void VertexPacking::PackNormalizedShort(const float *source, size_t count, unsigned int components, void *destination, size_t stride) {
+    PackComponents(source, count, components, sizeof(NormalizedShort), destination, stride, NormalizedShortRun);
+}
+
+void VertexPacking::PackNormalizedUShort(const float *source, size_t count, unsigned int components, void *destination, size_t stride) {
+    PackComponents(source, count, components, sizeof(NormalizedUShort), destination, stride, NormalizedUShortRun);
+}
+
+void VertexPacking::PackNormals(const float *source, size_t count, unsigned int components, void *destination, size_t stride) {
+    auto* out = static_cast<unsigned char*>(destination);
+    if (stride == 0)
+        stride = sizeof(PackedNormal);
+
+    size_t i = 0;
+#if PACKING_SSE2
+    // Four vectors at a time, transposed so each register holds one component
+    const __m128 low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(511.0f);
+    const __m128i mask = _mm_set1_epi32(0x3ff);
+    for (; i + 4 <= count; i += 4) {
+        const float* v = source + i * components;
+        __m128 x, y, z, w;
+        if (components == 4) {
+            x = _mm_loadu_ps(v);
+            y = _mm_loadu_ps(v + 4);
+            z = _mm_loadu_ps(v + 8);
+            w = _mm_loadu_ps(v + 12);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+        } else {
+            x = _mm_setr_ps(v[0], v[3], v[6], v[9]);
+            y = _mm_setr_ps(v[1], v[4], v[7], v[10]);
+            z = _mm_setr_ps(v[2], v[5], v[8], v[11]);
+            w = _mm_setzero_ps();
+        }
+
+        const __m128i ix = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, low), high), scale));
+        const __m128i iy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(y, low), high), scale));
+        const __m128i iz = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(z, low), high), scale));
+        const __m128i iw = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(w, low), high));
+        __m128i bits = _mm_and_si128(ix, mask);
+        bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(iy, mask), 10));
+        bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(iz, mask), 20));
+        bits = _mm_or_si128(bits, _mm_slli_epi32(iw, 30));
+
+        alignas(16) uint32_t words[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(words), bits);
+        for (size_t k = 0; k < 4; k++)
+            std::memcpy(out + (i + k) * stride, &words[k], sizeof(uint32_t));
+    }
+#endif
+    for (; i < count; i++) {
+        const float* v = source + i * components;
+        const PackedNormal packed = ToPackedNormal({ v[0], v[1], v[2], components == 4 ? v[3] : 0.0f });
+        std::memcpy(out + i * stride, &packed, sizeof(PackedNormal));
+    }
+}
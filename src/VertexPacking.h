@@ -0,0 +1,50 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Storage types for compact vertex attributes. VertexBufferLayout::Push maps
+// each to its GL format; the shader still reads floats.
+struct HalfFloat {
+    uint16_t Bits;
+};
+
+// [-1, 1] in 16 bits
+struct NormalizedShort {
+    int16_t Value;
+};
+
+// [0, 1] in 16 bits
+struct NormalizedUShort {
+    uint16_t Value;
+};
+
+// A normalized signed vec4 in one word: 10 bits each for x, y and z, 2 for w
+struct PackedNormal {
+    uint32_t Bits;
+};
+
+// Float to compact format conversion. The bulk functions read count vectors
+// of `components` floats each, tightly packed, and write vectors `stride`
+// bytes apart so they can fill one attribute of an interleaved buffer; a
+// stride of 0 packs them tightly. Values are rounded to nearest and
+// normalized formats clamp to their range.
+class VertexPacking {
+public:
+    static HalfFloat ToHalf(float value);
+    static float FromHalf(HalfFloat value);
+    static NormalizedShort ToNormalizedShort(float value);
+    static NormalizedUShort ToNormalizedUShort(float value);
+    static PackedNormal ToPackedNormal(const glm::vec4& value);
+
+    static void PackHalf(const float* source, size_t count, unsigned int components, void* destination, size_t stride = 0);
+    static void PackNormalizedShort(const float* source, size_t count, unsigned int components, void* destination, size_t stride = 0);
+    static void PackNormalizedUShort(const float* source, size_t count, unsigned int components, void* destination, size_t stride = 0);
+    // components is 3 or 4; without a w it packs as 0
+    static void PackNormals(const float* source, size_t count, unsigned int components, void* destination, size_t stride = 0);
+};
@@ -0,0 +1,100 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#include "Window.h"
+
+#include <GL/glew.h> // Must be included before GLFW
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+
+#include "GLObjectPool.h"
+#include "Renderer.h"
+
+#define GLFW_HAS_NULL_PLATFORM (GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4))
+
+Window::Window(const WindowSpecification& specification) : m_Specification(specification) {
+    if (m_Specification.Headless) {
+#if GLFW_HAS_NULL_PLATFORM
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+        std::cerr << "Headless mode needs GLFW 3.4, using a hidden window instead" << std::endl;
+#endif
+    }
+
+    /* Initialize the library */
+    if (!glfwInit())
+        return;
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#if GL_CHECKS == GL_CHECKS_DEBUG_CALLBACK
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+
+    if (m_Specification.Headless) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#if GLFW_HAS_NULL_PLATFORM
+        // Mesa's llvmpipe provides both, EGL surfaceless is preferred
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        m_Window = glfwCreateWindow(m_Specification.Width, m_Specification.Height, m_Specification.Title.c_str(), nullptr, nullptr);
+        if (!m_Window)
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+    }
+
+    /* Create a windowed mode window and its OpenGL context */
+    if (!m_Window)
+        m_Window = glfwCreateWindow(m_Specification.Width, m_Specification.Height, m_Specification.Title.c_str(), nullptr, nullptr);
+
+    if (!m_Window) {
+        std::cerr << "Failed to create an OpenGL 3.3 context" << std::endl;
+        glfwTerminate();
+        return;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(m_Window);
+
+    glfwSwapInterval(m_Specification.VSync && !m_Specification.Headless ? 1 : 0);
+
+    const GLenum error = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX has no display to query with an EGL or OSMesa
+    // context, but the core entry points are loaded regardless
+    if (error != GLEW_OK && error != GLEW_ERROR_NO_GLX_DISPLAY)
+#else
+    if (error != GLEW_OK)
+#endif
+        std::cerr << "Error! " << glewGetErrorString(error) << std::endl;
+
+#if GL_CHECKS == GL_CHECKS_DEBUG_CALLBACK
+    if (!GLEnableDebugOutput())
+        std::cerr << "KHR_debug is not available, OpenGL errors will not be reported" << std::endl;
+#endif
+}
+
+Window::~Window() {
+    if (!m_Window)
+        return;
+
+    GLObjectPool::Shutdown();
+    glfwDestroyWindow(m_Window);
+    glfwTerminate();
+}
+
+bool Window::ShouldClose() const {
+    return glfwWindowShouldClose(m_Window);
+}
+
+void Window::SwapBuffers() const {
+    // A headless context has no default framebuffer to present
+    if (!m_Specification.Headless)
+        glfwSwapBuffers(m_Window);
+}
+
+void Window::PollEvents() const {
+    glfwPollEvents();
+}
@@ -0,0 +1,42 @@
+//
+// Created by chrisvega on 10/17/26.
+//
+
+#pragma once
+
+#include <string>
+
+struct GLFWwindow;
+
+struct WindowSpecification {
+    std::string Title = "Hello World";
+    int Width = 960;
+    int Height = 540;
+    bool VSync = true;
+    // No window system at all: the context comes from EGL (surfaceless) or
+    // OSMesa and everything is drawn into Framebuffers. Needs GLFW 3.4.
+    bool Headless = false;
+};
+
+// Owns GLFW, the window and its OpenGL 3.3 core context
+class Window {
+private:
+    GLFWwindow* m_Window = nullptr;
+    WindowSpecification m_Specification;
+public:
+    explicit Window(const WindowSpecification& specification = {});
+    ~Window();
+
+    Window(const Window&) = delete;
+    Window& operator=(const Window&) = delete;
+
+    bool ShouldClose() const;
+    void SwapBuffers() const;
+    void PollEvents() const;
+
+    inline bool IsValid() const { return m_Window != nullptr; }
+    inline bool IsHeadless() const { return m_Specification.Headless; }
+    inline GLFWwindow* GetNativeWindow() const { return m_Window; }
+    inline int GetWidth() const { return m_Specification.Width; }
+    inline int GetHeight() const { return m_Specification.Height; }
+};
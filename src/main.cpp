@@ -1,12 +1,24 @@
 #include <GL/glew.h> // Must be included before GLFW
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <csignal>
+#include <vector>
 
 #include "Renderer.h"
+#include "BatchRenderer.h"
+#include "Culling.h"
+#include "Font.h"
+#include "GLStateCache.h"
+#include "JobSystem.h"
+#include "ParticleRenderer.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
+#include "ResourceManager.h"
 
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
@@ -14,6 +26,10 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "TextObject.h"
+#include "TextureLoader.h"
+#include "TransformSystem.h"
+#include "Window.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -22,112 +38,226 @@
 #include "imgui/imgui_impl_glfw_gl3.h"
 
 int main() {
-    /* Initialize the library */
-    if (!glfwInit())
+    Window window({ "Hello World", 960, 540 });
+    if (!window.IsValid())
         return -1;
 
-    /* Create a windowed mode window and its OpenGL context */
-    GLFWwindow* window = glfwCreateWindow(960, 540, "Hello World", nullptr, nullptr);
-
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-
-    glewInit();
-
-    if (!window) {
-        glfwTerminate();
-        return -1;
-    }
-
-    /* Make the window's context current */
-    glfwMakeContextCurrent(window);
+    std::cout << glGetString(GL_VERSION) << std::endl;
 
-    glfwSwapInterval(1);
+    {
+        GLCall(glEnable(GL_BLEND));
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 
-    if (glewInit() != GLEW_OK)
-        std::cerr << "Error!" << std::endl;
+        glm::mat4 proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+        glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
 
-    std::cout << glGetString(GL_VERSION) << std::endl;
+        ResourceManager resources;
+        // Streamed rather than loaded through the manager; the loader shares
+        // its path normalization, so a path is still only loaded once
+        TextureLoader textureLoader;
+        std::shared_ptr<Texture> texture = textureLoader.Load("res/textures/cube.png");
+        std::shared_ptr<Texture> guitarTexture = textureLoader.Load("res/textures/guitar.png");
+
+        // A single quad mesh drawn many times with per-instance model matrices
+        const float positions[] = {
+            -10.0f, -10.0f,   // 0
+             10.0f, -10.0f,   // 1
+             10.0f,  10.0f,   // 2
+            -10.0f,  10.0f    // 3
+        };
+        const float texCoords[] = {
+            0.0f, 0.0f,
+            1.0f, 0.0f,
+            1.0f, 1.0f,
+            0.0f, 1.0f
+        };
 
-    {
-        float positions[] = {
-            -50.0f, -50.0f, 0.0f, 0.0f,   // 0
-             50.0f, -50.0f, 1.0f, 0.0f,   // 1
-             50.0f,  50.0f, 1.0f, 1.0f,   // 2
-            -50.0f,  50.0f, 0.0f, 1.0f    // 3
+        // Half positions and 16-bit UVs: 8 bytes a vertex instead of 16
+        struct CompactVertex {
+            HalfFloat Position[2];
+            NormalizedUShort TexCoord[2];
         };
+        CompactVertex vertices[4];
+        VertexPacking::PackHalf(positions, 4, 2, vertices[0].Position, sizeof(CompactVertex));
+        VertexPacking::PackNormalizedUShort(texCoords, 4, 2, vertices[0].TexCoord, sizeof(CompactVertex));
 
         unsigned int indices[] = {
             0, 1, 2,
             2, 3, 0
         };
 
-        GLCall(glEnable(GL_BLEND));
-        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-
         VertexArray va;
-        VertexBuffer vb(positions, 4 * 4 * sizeof(float));
+        VertexBuffer vb(vertices, sizeof(vertices));
 
         VertexBufferLayout layout;
-        layout.Push<float>(2);
-        layout.Push<float>(2);
+        layout.Push<HalfFloat>(2);
+        layout.Push<NormalizedUShort>(2);
         va.AddBuffer(vb, layout);
 
         IndexBuffer ib(indices, 6);
 
-        glm::mat4 proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
-        glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
-
-        Shader shader("res/shaders/Basic.shader");
-        shader.Bind();
-        shader.SetUniform4f("u_Color", 0.8f, 0.3f, 0.8f, 1.0f);
-
-        Texture texture("res/textures/cube.png");
-        texture.Bind(); // slot 0 by default
-        shader.SetUniform1i("u_Texture", 0);
+        // The grid hangs off one root transform, so moving the root updates every instance
+        constexpr unsigned int gridColumns = 40;
+        constexpr unsigned int gridRows = 6;
+        constexpr unsigned int gridCount = gridColumns * gridRows;
+        TransformSystem transforms;
+        glm::vec3 gridOffset(0.0f);
+        const TransformID gridRoot = transforms.Create(gridOffset);
+        const TransformID gridFirst = gridRoot + 1;
+        for (unsigned int y = 0; y < gridRows; y++) {
+            for (unsigned int x = 0; x < gridColumns; x++)
+                transforms.Create(glm::vec3(12.0f + x * 24.0f, 400.0f + y * 24.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f), gridRoot);
+        }
 
+        glm::vec3 translationA(200, 200, 0);
+        glm::vec3 translationB(400, 200, 0);
+        const TransformID quadA = transforms.Create(translationA, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(100.0f, 100.0f, 1.0f));
+        const TransformID quadB = transforms.Create(translationB, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(100.0f, 100.0f, 1.0f));
+
+        // Grid quads are filed in a spatial grid in creation order, so object i is transform gridFirst + i
+        const AABB quadBounds = { glm::vec3(-10.0f, -10.0f, 0.0f), glm::vec3(10.0f, 10.0f, 0.0f) };
+        SpatialGrid grid(64.0f);
+        for (unsigned int i = 0; i < gridCount; i++)
+            grid.Insert(quadBounds);
+        std::vector<SpatialGrid::ObjectID> visibleInstances;
+        std::vector<glm::mat4> visibleMatrices;
+        bool instancesChanged = false;
+
+        VertexBuffer instanceVb(gridCount * sizeof(glm::mat4));
+        VertexBufferLayout instanceLayout;
+        instanceLayout.Push<glm::mat4>(1, 1);
+        va.AddBuffer(instanceVb, instanceLayout);
+
+        // Loading the same path again hands back this shader. The reference is
+        // good until the next shader is loaded, which may move the pool.
+        const ResourceHandle<Shader> instancedShaderHandle = resources.LoadShader("res/shaders/Instanced.shader");
+        if (!instancedShaderHandle.IsValid())
+            return -1;
+        Shader& instancedShader = *resources.Get(instancedShaderHandle);
+        instancedShader.Bind();
+        instancedShader.SetUniform1i("u_Texture", 0);
+        // Edits to the .shader file are rebuilt in the background and swapped in
+        instancedShader.SetHotReload(true);
 
         va.Unbind();
-        shader.Unbind();
-        vb.Unbind();
-        ib.Unbind();
+        instancedShader.Unbind();
 
         Renderer renderer;
+        BatchRenderer batch;
+
+        // Any TrueType font will do; without one the HUD is left out
+        Font hudFont("res/fonts/SourceCodePro-Regular.ttf");
+        TextObject hudText(hudFont, "", glm::vec3(10.0f, 520.0f, 0.0f), 18.0f);
+
+        // A fountain simulated on the CPU and streamed to the GPU every frame
+        constexpr unsigned int maxParticles = 50000;
+        ParticleSystem particles(maxParticles);
+        ParticleRenderer particleRenderer(maxParticles);
+        ParticleEmitDescription fountain;
+        fountain.Position = glm::vec3(480.0f, 40.0f, 0.0f);
+        fountain.PositionSpread = glm::vec3(6.0f, 2.0f, 0.0f);
+        fountain.Velocity = glm::vec3(0.0f, 480.0f, 0.0f);
+        fountain.VelocitySpread = glm::vec3(120.0f, 80.0f, 0.0f);
+        fountain.Lifetime = 1.5f;
+        fountain.LifetimeSpread = 0.3f;
+        particles.SetGravity(glm::vec3(0.0f, -400.0f, 0.0f));
+        particles.SetRamp({ glm::vec4(1.0f, 0.9f, 0.4f, 1.0f), glm::vec4(0.9f, 0.2f, 0.05f, 0.0f), 6.0f, 2.0f });
+        // Emission follows the frame time; the fraction carries over
+        const float particlesPerSecond = maxParticles / (fountain.Lifetime + fountain.LifetimeSpread);
+        float particlesToEmit = 0.0f;
 
         ImGui::CreateContext();
-        ImGui_ImplGlfwGL3_Init(window, true);
+        ImGui_ImplGlfwGL3_Init(window.GetNativeWindow(), true);
         ImGui::StyleColorsDark();
 
-        glm::vec3 translationA(200, 200, 0);
-        glm::vec3 translationB(400, 200, 0);
-
         float r = 0.0f;
         float increment = 0.05f;
 
-        while (!glfwWindowShouldClose(window)) {
+        float lastTime = static_cast<float>(glfwGetTime());
+
+        // Moves the transforms, refreshes the moved instances' cells and gathers
+        // what the camera sees. Runs as a job that overlaps the previous frame's
+        // submission, so it only touches state the render thread is done with.
+        JobSystem jobs;
+        JobCounter simulation;
+        auto simulate = [&](const glm::vec3& gridPosition, const glm::vec3& positionA, const glm::vec3& positionB) {
+            PROFILE_SCOPE("Simulate");
+            transforms.SetPosition(gridRoot, gridPosition);
+            transforms.SetPosition(quadA, positionA);
+            transforms.SetPosition(quadB, positionB);
+            transforms.Update();
+
+            // The camera is fixed, so the visible set and the instance data only
+            // change when something moved
+            const TransformID changedBegin = std::max(transforms.GetChangedBegin(), gridFirst);
+            const TransformID changedEnd = std::min(transforms.GetChangedEnd(), gridFirst + gridCount);
+            instancesChanged = changedBegin < changedEnd;
+            if (!instancesChanged)
+                return;
+
+            for (TransformID id = changedBegin; id < changedEnd; id++)
+                grid.Update(id - gridFirst, quadBounds.Transformed(transforms.GetWorldMatrix(id)));
+
+            visibleInstances.clear();
+            grid.Query(Frustum(proj * view), visibleInstances);
+            visibleMatrices.resize(visibleInstances.size());
+            jobs.ParallelFor(visibleInstances.size(), 256, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++)
+                    visibleMatrices[i] = transforms.GetWorldMatrix(gridFirst + visibleInstances[i]);
+            });
+        };
+        // The inputs are copied, so the UI can edit them while the job runs
+        auto startSimulation = [&] {
+            jobs.Run([&, gridPosition = gridOffset, positionA = translationA, positionB = translationB] {
+                simulate(gridPosition, positionA, positionB);
+            }, &simulation);
+        };
+        startSimulation();
+
+        Profiler::SetThreadName("Main");
+        while (!window.ShouldClose()) {
+            Profiler::BeginFrame();
+            const float time = static_cast<float>(glfwGetTime());
+            GLStateCache::ResetStats();
+            const float deltaTime = time - lastTime;
+            renderer.BeginFrame(view, proj, time, deltaTime);
             renderer.Clear();
+            lastTime = time;
 
             ImGui_ImplGlfwGL3_NewFrame();
 
-            {
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), translationA);
-                glm::mat4 mvp = proj * view * model;
-                shader.Bind();
-                shader.SetUniformMat4f("u_MVP", mvp);
+            textureLoader.ProcessUploads();
+            instancedShader.CheckForReload();
 
-                renderer.Draw(va, ib, shader);
-            }
+            // Started while the last frame was being submitted; the render thread
+            // runs jobs while it waits
+            jobs.Wait(simulation);
+            if (instancesChanged && !visibleMatrices.empty())
+                instanceVb.SetData(visibleMatrices.data(), visibleMatrices.size() * sizeof(glm::mat4));
 
-            {
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), translationB);
-                glm::mat4 mvp = proj * view * model;
-                shader.Bind();
-                shader.SetUniformMat4f("u_MVP", mvp);
+            if (!visibleMatrices.empty()) {
+                texture->Bind();
+                renderer.DrawInstanced(va, ib, instancedShader, static_cast<unsigned int>(visibleMatrices.size()));
+            }
 
-                renderer.Draw(va, ib, shader);
+            particlesToEmit += particlesPerSecond * deltaTime;
+            particlesToEmit -= static_cast<float>(particles.Emit(fountain, static_cast<size_t>(particlesToEmit)));
+            particlesToEmit = std::min(particlesToEmit, 1.0f);
+            particles.Update(deltaTime, &jobs);
+            particleRenderer.Draw(renderer, particles, &jobs);
+
+            batch.ResetStats();
+            batch.BeginScene();
+            batch.DrawQuad(transforms.GetWorldMatrix(quadA), *texture);
+            batch.DrawQuad(transforms.GetWorldMatrix(quadB), *guitarTexture);
+            if (hudFont.IsValid()) {
+                // Only laid out again on the frames the numbers change
+                char hud[128];
+                std::snprintf(hud, sizeof(hud), "Grid visible %u\nGrid culled %u", grid.GetStats().Visible, grid.GetStats().Culled);
+                hudText.SetText(hud);
+                batch.DrawText(hudText);
             }
+            batch.EndScene();
 
             if (r > 1.0f)
                 increment = -0.05f;
@@ -139,22 +269,43 @@ int main() {
             {
                 ImGui::SliderFloat3("Translation A", &translationA.x, 0.0f, 960.0f);
                 ImGui::SliderFloat3("Translation B", &translationB.x, 0.0f, 960.0f);
+                ImGui::SliderFloat3("Grid offset", &gridOffset.x, -400.0f, 400.0f);
+                const BatchRenderer::Stats& stats = batch.GetStats();
+                ImGui::Text("Quads: %u  Flushes: %u  Draw calls: %u", stats.QuadCount, stats.FlushCount, stats.DrawCalls);
+                const SpatialGrid::Stats& cullStats = grid.GetStats();
+                ImGui::Text("Grid visible: %u  culled: %u", cullStats.Visible, cullStats.Culled);
+                ImGui::Text("Particles: %zu", particles.GetCount());
+                const GLStateCache::Stats& stateStats = GLStateCache::GetStats();
+                const JobSystem::Stats jobStats = jobs.GetStats();
+                ImGui::Text("Jobs run: %u  stolen: %u  threads: %u", jobStats.Executed, jobStats.Stolen, jobs.GetThreadCount());
+                ImGui::Text("State changes issued: %u  skipped: %u", stateStats.Issued, stateStats.Skipped);
                 ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
             }
+            Profiler::DrawImGui();
+
+            // Everything this frame draws is recorded, so the next frame's
+            // simulation can run alongside its submission and the swap
+            startSimulation();
 
-            ImGui::Render();
-            ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+            {
+                PROFILE_GPU_SCOPE("ImGui");
+                ImGui::Render();
+                ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+                // ImGui binds its own program, buffers and textures directly
+                GLStateCache::Invalidate();
+            }
 
             /* Swap front and back buffers */
-            glfwSwapBuffers(window);
+            window.SwapBuffers();
 
             /* Poll for and process events */
-            glfwPollEvents();
+            window.PollEvents();
+            Profiler::EndFrame();
         }
+        jobs.Wait(simulation);
     }
 
     ImGui_ImplGlfwGL3_Shutdown();
     ImGui::DestroyContext();
-    glfwTerminate();
     return 0;
 }